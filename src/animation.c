@@ -2,76 +2,105 @@
  * \file animation.c
  * \brief this file contains necessary function to display animations
  *
- * Implementation of drawAnimatedEntity() and changeAnimation()
+ * Implementation of updateAnimation(), drawAnimatedEntity(), drawAnimationFrame() and changeAnimation()
  *
  * \author François-Xavier Balu, Gwendal Henry, Martin Parisot, Vincent Werner
  */
 
 #include "animation.h"
 #include "draw.h"
+#include "render.h"
 
 /**
- * \fn void drawAnimatedEntity(GameObject* entity, Game* game)
- * \brief displays an animated object
+ * \fn void updateAnimation(GameObject* entity, Game* game)
+ * \brief times the frames of an animated object
  *
- * \param[in] entity: contains the sprite and other informations for the animation
+ * \param[in, out] entity: contains the clip and other informations for the animation
  * \param[in] game: containins the necessary informations about the game
  *
- * This function manage the animation of an object, times the frames and
- *	displays the right part of the sprite each frame
+ * This function moves to the next frame of the clip when the timer of the current one is over.
+ * It is called each frame even for the objects out of the screen (updateObject() times the monsters),
+ *	so they are at the same frame when they appear as if they had been drawn.
  */
-void drawAnimatedEntity(GameObject* entity, Game* game)
+void updateAnimation(GameObject* entity, Game* game)
 {
+    Clip* clip = &(game->atlas->clips[entity->clip]);
+
     // Gestion du timer
 
     // Si notre timer (un compte à rebours en fait) arrive à zéro
 
     if(entity->frameTimer <= 0)
     {
-        entity->frameTimer = TIME_BETWEEN_2_FRAMES;
+        entity->frameTimer = clip->frameDuration;
 
         entity->frameNumber ++;
 
-        if(entity->frameNumber >= entity->sprite->w/entity->w) entity->frameNumber =0;
+        if(entity->frameNumber >= clip->frameCount) entity->frameNumber =0;
 
     }
 
     else entity->frameTimer --;
+}
+
+/**
+ * \fn void drawAnimatedEntity(GameObject* entity, Game* game)
+ * \brief displays an animated object
+ *
+ * \param[in] entity: contains the clip and other informations for the animation
+ * \param[in] game: containins the necessary informations about the game
+ *
+ * This function manage the animation of an object, times the frames and
+ *	displays the right part of the atlas each frame
+ */
+void drawAnimatedEntity(GameObject* entity, Game* game)
+{
+    updateAnimation(entity, game);
 
+    drawAnimationFrame(entity, game);
+}
+
+/**
+ * \fn void drawAnimationFrame(GameObject* entity, Game* game)
+ * \brief displays the current frame of an animated object, without timing it
+ *
+ * \param[in] entity: contains the clip and other informations for the animation
+ * \param[in] game: containins the necessary informations about the game
+ */
+void drawAnimationFrame(GameObject* entity, Game* game)
+{
     SDL_Rect dest;
 
     dest.x = entity->x - game->map->startX;
     dest.y = entity->y - game->map->startY;
-    dest.w = entity->w;
-    dest.h = entity->h;
 
     SDL_Rect src;
 
-    src.x = entity->frameNumber * entity->w;
-    src.y = 0;
-    src.h = entity->h;
-    src.w = entity->w;
+    getClipFrame(game->atlas, entity->clip, entity->frameNumber, &src);
 
-    SDL_BlitSurface(entity->sprite, &src, game->screen, &dest);
+    drawSurface(game->atlas->surface, &src, &dest, game);
 }
 
 /**
- * \fn void changeAnimation(GameObject* entity, char* name)
+ * \fn void changeAnimation(GameObject* entity, int clip, Game* game)
  * \brief changes the animation for a given animated object
  *
  * \param[in] entity: 'GameObject' contains informations about the object
- * \param[in] name: 'char*' contains the name of the new sprite to load
+ * \param[in] clip: 'int' the new animation (CLIP_*)
+ * \param[in] game: containins the atlas, with the duration of the frames of each clip
  *
- *  This function changes the sprite loaded up in the 'GameObject' entity,
- *	allowing us to change the animation of an animated object
+ *  This function changes the clip of the 'GameObject' entity,
+ *	allowing us to change the animation of an animated object.
+ *	The frames are already in the atlas, nothing is loaded.
  */
-void changeAnimation(GameObject* entity, char* name)
+void changeAnimation(GameObject* entity, int clip, Game* game)
 {
-    if(entity->sprite != NULL) SDL_FreeSurface(entity->sprite);
-
-    entity->sprite = loadImage(name);
+    entity->clip = clip;
 
     entity->frameNumber = 0;
-    entity->frameTimer = TIME_BETWEEN_2_FRAMES;
+
+    /* l'atlas n'est créé qu'au premier loadGame(), le joueur est initialisé avant */
+    if(game->atlas != NULL) entity->frameTimer = game->atlas->clips[clip].frameDuration;
+    else entity->frameTimer = TIME_BETWEEN_2_FRAMES;
 
 }
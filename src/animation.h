@@ -2,7 +2,7 @@
  * \file animation.h
  * \brief header of animation.c
  *
- *	Contains declarations of drawAnimatedEntity() and changeAnimation()
+ *	Contains declarations of updateAnimation(), drawAnimatedEntity(), drawAnimationFrame() and changeAnimation()
  *
  * \author François-Xavier Balu, Gwendal Henry, Martin Parisot, Vincent Werner
  */
@@ -12,7 +12,9 @@
 
 #include "game.h"
 
+void updateAnimation(GameObject* entity, Game* game);
 void drawAnimatedEntity(GameObject* entity, Game* game);
-void changeAnimation(GameObject* entity, char* name);
+void drawAnimationFrame(GameObject* entity, Game* game);
+void changeAnimation(GameObject* entity, int clip, Game* game);
 
 #endif // ANIMATION_H_INCLUDED
@@ -0,0 +1,163 @@
+/**
+ * \file arena.c
+ * \brief contains the memory of the data which live as long as a level
+ *
+ * Implementation of createArena, arenaAlloc, resetArena and destroyArena.
+ *
+ * An arena gives memory one after the other in large blocks, and never frees a single allocation:
+ * everything is given back at once by resetArena(), when another level is loaded. The blocks are kept
+ * for the next level, so loading levels one after the other doesn't allocate memory again,
+ * and the memory used stays the one of the largest level.
+ *
+ * \author François-Xavier Balu, Gwendal Henry, Martin Parisot, Vincent Werner
+ */
+
+#include "arena.h"
+
+
+/**
+ * \fn static ArenaBlock* createArenaBlock(size_t size)
+ * \brief Create an empty block of size bytes, NULL if the allocation failed
+ */
+static ArenaBlock* createArenaBlock(size_t size) {
+
+   ArenaBlock* block;
+
+   if((block = (ArenaBlock*)malloc(sizeof(ArenaBlock))) == NULL) return NULL;
+
+   if((block->data = (unsigned char*)malloc(size)) == NULL) {
+      free(block);
+
+      return NULL;
+   }
+
+   block->size = size;
+   block->used = 0;
+   block->next = NULL;
+
+   return block;
+}
+
+/**
+ * \fn static void destroyArenaBlocks(ArenaBlock* block)
+ * \brief Free a block and the ones after it
+ */
+static void destroyArenaBlocks(ArenaBlock* block) {
+
+   ArenaBlock* next;
+
+   while(block != NULL) {
+      next = block->next;
+
+      free(block->data);
+      free(block);
+
+      block = next;
+   }
+}
+
+/**
+ * \fn Arena* createArena(size_t blockSize)
+ * \brief Create the Arena structure, with a first block
+ *
+ * \param[in] blockSize: size of the blocks in bytes, it should hold most of the data of a level
+ * \return the Arena structure, NULL if the allocation failed
+ */
+Arena* createArena(size_t blockSize) {
+
+   Arena* arena;
+
+   if((arena = (Arena*)malloc(sizeof(Arena))) == NULL) {
+      fprintf(stderr, "can't allocate memory for an Arena\n");
+
+      return NULL;
+   }
+
+   arena->blockSize = blockSize;
+
+   if((arena->first = createArenaBlock(blockSize)) == NULL) {
+      fprintf(stderr, "can't allocate memory for an Arena\n");
+      free(arena);
+
+      return NULL;
+   }
+
+   arena->current = arena->first;
+
+   return arena;
+}
+
+/**
+ * \fn void* arenaAlloc(Arena* arena, size_t size)
+ * \brief Give a zone of size bytes, aligned on ARENA_ALIGN, until the next resetArena()
+ *
+ * \param[in, out] arena
+ * \param[in] size: size in bytes, the zone isn't initialized
+ * \return the zone, NULL if a new block couldn't be allocated
+ */
+void* arenaAlloc(Arena* arena, size_t size) {
+
+   ArenaBlock* block = arena->current;
+   void* zone;
+
+   size = (size + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1);
+
+   /* bloc suivant, gardé d'un niveau précédent ou nouveau : la fin du bloc courant reste inutilisée */
+   while(block->used + size > block->size) {
+
+      if(block->next == NULL) {
+         if((block->next = createArenaBlock(size > arena->blockSize ? size : arena->blockSize)) == NULL) return NULL;
+      }
+
+      block = block->next;
+      block->used = 0;
+   }
+
+   arena->current = block;
+
+   zone = block->data + block->used;
+   block->used += size;
+
+   return zone;
+}
+
+/**
+ * \fn void resetArena(Arena* arena)
+ * \brief Give back every zone of the arena at once
+ *
+ * \param[in, out] arena
+ *
+ * If the previous level needed several blocks, they are replaced by a single one as large as all of them,
+ * so the next levels fit in one block. If it can't be allocated, the blocks are kept.
+ */
+void resetArena(Arena* arena) {
+
+   ArenaBlock *block, *large;
+   size_t size = 0;
+
+   if(arena->first->next != NULL) {
+
+      for(block = arena->first; block != NULL; block = block->next) size += block->size;
+
+      if((large = createArenaBlock(size)) != NULL) {
+         destroyArenaBlocks(arena->first);
+         arena->first = large;
+      }
+   }
+
+   arena->first->used = 0;
+   arena->current = arena->first;
+}
+
+/**
+ * \fn void destroyArena(Arena* arena)
+ * \brief Free the Arena structure and its blocks
+ */
+void destroyArena(Arena* arena) {
+
+   if(arena != NULL) {
+
+      destroyArenaBlocks(arena->first);
+      free(arena);
+   }
+}
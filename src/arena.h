@@ -0,0 +1,47 @@
+/**
+ * \file arena.h
+ * \brief header of arena.c
+ *
+ * Creation of the ArenaBlock and Arena structures.
+ * Declaration of createArena(), arenaAlloc(), resetArena() and destroyArena().
+ *
+ * \author François-Xavier Balu, Gwendal Henry, Martin Parisot, Vincent Werner
+ */
+
+#ifndef ARENA_H_INCLUDED
+#define ARENA_H_INCLUDED
+
+#include "common.h"
+
+/* alignement des zones données par arenaAlloc() */
+#define ARENA_ALIGN 16
+
+
+typedef struct ArenaBlock{
+
+    unsigned char *data;
+    size_t size, used;
+
+    struct ArenaBlock *next;
+
+}ArenaBlock;
+
+
+typedef struct Arena{
+
+    /* blocs gardés d'une remise à zéro à l'autre ; les zones sont données dans current */
+    ArenaBlock *first, *current;
+
+    /* taille d'un nouveau bloc, sauf pour une zone plus grande */
+    size_t blockSize;
+
+}Arena;
+
+
+Arena* createArena(size_t blockSize);
+void* arenaAlloc(Arena* arena, size_t size);
+void resetArena(Arena* arena);
+void destroyArena(Arena* arena);
+
+
+#endif // ARENA_H_INCLUDED
@@ -0,0 +1,161 @@
+/**
+ * \file atlas.c
+ * \brief contains the functions to pack the animation strips into one surface
+ *
+ * Implementation of createAtlas, getClipFrame and destroyAtlas.
+ *
+ * Every strip of the characters and monsters is loaded once at startup and copied
+ * on its own row of the atlas. Changing an animation only changes the clip index
+ * of an object, nothing is read from the disk during the game.
+ *
+ * \author François-Xavier Balu, Gwendal Henry, Martin Parisot, Vincent Werner
+ */
+
+#include "common.h"
+#include "atlas.h"
+#include "draw.h"
+#include "render.h"
+
+
+/* fichier et largeur d'une frame de chaque animation, dans l'ordre des CLIP_* */
+static const struct {
+
+   char *file;
+   int frameWidth;
+
+} clipFiles[CLIP_NUMBER] = {
+
+   { "data/graphics/idle.png", PLAYER_WIDTH },
+   { "data/graphics/walkleft.png", PLAYER_WIDTH },
+   { "data/graphics/walkright.png", PLAYER_WIDTH },
+   { "data/graphics/jumpleft.png", PLAYER_WIDTH },
+   { "data/graphics/jumpright.png", PLAYER_WIDTH },
+   { "data/graphics/flyleft.png", MONSTER_WIDTH },
+   { "data/graphics/flyright.png", MONSTER_WIDTH },
+   { "data/graphics/flydead.png", MONSTER_WIDTH }
+};
+
+
+/**
+ * \fn static void copyStrip(SDL_Surface* strip, SDL_Surface* surface, int y)
+ * \brief copies a strip on its row of the atlas, with its alpha channel and without blending
+ *
+ * The strip is shared by the image cache and must not be modified: the copy is done
+ * from a private copy of the strip, converted to the format of the atlas, whose blending is turned off.
+ * If the copy can't be made, the row stays transparent.
+ */
+static void copyStrip(SDL_Surface* strip, SDL_Surface* surface, int y) {
+
+   SDL_Surface* copy;
+   SDL_Rect dest;
+
+   if((copy = SDL_ConvertSurface(strip, surface->format, SDL_SWSURFACE)) == NULL) {
+      fprintf(stderr, "can't copy a strip in the atlas: %s\n", SDL_GetError());
+      return;
+   }
+
+   SDL_SetAlpha(copy, 0, SDL_ALPHA_OPAQUE);
+
+   dest.x = 0;
+   dest.y = y;
+   SDL_BlitSurface(copy, NULL, surface, &dest);
+
+   SDL_FreeSurface(copy);
+}
+
+/**
+ * \fn Atlas* createAtlas()
+ * \brief Create the Atlas structure and pack every animation strip into it
+ *
+ * The strips are stacked one under the other, the atlas is as wide as the widest strip.
+ * The alpha channel of the strips is copied as is, then the atlas is blended when drawn.
+ * If a picture can't be loaded or the allocation failed the function returns NULL.
+ */
+Atlas* createAtlas() {
+
+   Atlas* atlas;
+   SDL_Surface* strips[CLIP_NUMBER];
+   SDL_PixelFormat* format;
+   int i, w = 0, h = 0;
+
+   for(i = 0; i < CLIP_NUMBER; i++) {
+      strips[i] = loadImage(clipFiles[i].file);
+
+      if(strips[i] == NULL) {
+         while(i-- > 0) releaseImage(strips[i]);
+
+         return NULL;
+      }
+
+      if(strips[i]->w > w) w = strips[i]->w;
+      h += strips[i]->h;
+   }
+
+   if((atlas = (Atlas*)malloc(sizeof(Atlas))) == NULL) {
+      fprintf(stderr, "can't allocate memory for an atlas\n");
+   } else {
+      format = strips[0]->format;
+
+      atlas->surface = SDL_CreateRGBSurface(SDL_SWSURFACE | SDL_SRCALPHA, w, h, format->BitsPerPixel,
+                                            format->Rmask, format->Gmask, format->Bmask, format->Amask);
+
+      if(atlas->surface == NULL) {
+         fprintf(stderr, "can't create the atlas: %s\n", SDL_GetError());
+         free(atlas);
+         atlas = NULL;
+      }
+   }
+
+   h = 0;
+
+   for(i = 0; i < CLIP_NUMBER; i++) {
+      if(atlas != NULL) {
+         copyStrip(strips[i], atlas->surface, h);
+
+         atlas->clips[i].x = 0;
+         atlas->clips[i].y = h;
+         atlas->clips[i].w = clipFiles[i].frameWidth < strips[i]->w ? clipFiles[i].frameWidth : strips[i]->w;
+         atlas->clips[i].h = strips[i]->h;
+         atlas->clips[i].frameCount = strips[i]->w / atlas->clips[i].w;
+         atlas->clips[i].frameDuration = TIME_BETWEEN_2_FRAMES;
+      }
+
+      h += strips[i]->h;
+      releaseImage(strips[i]);
+   }
+
+   return atlas;
+}
+
+/**
+ * \fn void getClipFrame(Atlas* atlas, int clip, int frame, SDL_Rect* rect)
+ * \brief gives the part of the atlas containing a frame of an animation
+ *
+ * \param[in] atlas: pointer to the Atlas structure.
+ * \param[in] clip: animation (CLIP_*).
+ * \param[in] frame: number of the frame in the animation.
+ * \param[out] rect: rectangle of the frame in atlas->surface.
+ */
+void getClipFrame(Atlas* atlas, int clip, int frame, SDL_Rect* rect) {
+
+   Clip* c = &(atlas->clips[clip]);
+
+   rect->x = c->x + (frame % c->frameCount) * c->w;
+   rect->y = c->y;
+   rect->w = c->w;
+   rect->h = c->h;
+}
+
+/**
+ * \fn void destroyAtlas(Atlas* atlas)
+ * \brief Free the Atlas structure
+ *
+ * \param[in] atlas: pointer to the Atlas structure.
+ */
+void destroyAtlas(Atlas* atlas) {
+
+   if(atlas != NULL) {
+      freeImage(atlas->surface);
+      free(atlas);
+   }
+}
@@ -0,0 +1,55 @@
+/**
+ * \file atlas.h
+ * \brief header of atlas.c
+ *
+ * Creation of the Clip and Atlas structures.
+ * Declaration of createAtlas(), getClipFrame() and destroyAtlas().
+ *
+ * \author François-Xavier Balu, Gwendal Henry, Martin Parisot, Vincent Werner
+ */
+
+#ifndef ATLAS_H_INCLUDED
+#define ATLAS_H_INCLUDED
+
+
+/* animations des personnages et des monstres */
+enum
+{
+    CLIP_IDLE,
+    CLIP_WALK_LEFT,
+    CLIP_WALK_RIGHT,
+    CLIP_JUMP_LEFT,
+    CLIP_JUMP_RIGHT,
+    CLIP_FLY_LEFT,
+    CLIP_FLY_RIGHT,
+    CLIP_FLY_DEAD,
+    CLIP_NUMBER
+};
+
+
+typedef struct Clip{
+
+    /* position de la première frame dans l'atlas, les suivantes sont à droite */
+    int x, y;
+    int w, h;
+
+    int frameCount;
+    int frameDuration;
+
+}Clip;
+
+
+typedef struct Atlas{
+
+    SDL_Surface *surface;
+    Clip clips[CLIP_NUMBER];
+
+}Atlas;
+
+
+Atlas* createAtlas();
+void getClipFrame(Atlas* atlas, int clip, int frame, SDL_Rect* rect);
+void destroyAtlas(Atlas* atlas);
+
+
+#endif // ATLAS_H_INCLUDED
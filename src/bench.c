@@ -0,0 +1,194 @@
+/**
+ * \file bench.c
+ * \brief contains the end-to-end benchmark of the levels
+ *
+ * Implementation of runBenchmark.
+ *
+ * Every level of data/map is played with the session recorded in data/replay/map<N>.rpl
+ * (see replay.c), or with a scripted session when there is no recording, without frame cap.
+ * The duration of each section of every frame is measured (see profile.c) and the results
+ * are written in a JSON file.
+ *
+ * \author François-Xavier Balu, Gwendal Henry, Martin Parisot, Vincent Werner
+ */
+
+#include "bench.h"
+#include "player.h"
+#include "replay.h"
+
+
+/**
+ * \fn static void getScriptedInput(int frame, Input* input)
+ * \brief inputs of the session used when a level has no recording
+ *
+ * \param[in] frame: number of the frame
+ * \param[out] input: the Input structure to fill
+ *
+ * The player runs to the right and jumps regularly.
+ */
+static void getScriptedInput(int frame, Input* input) {
+
+   memset(input, 0, sizeof(Input));
+
+   input->right = 1;
+   input->jump = frame % 40 < 12;
+}
+
+/**
+ * \fn static int fileExists(char* path)
+ * \brief returns 1 if the file can be read, 0 otherwise
+ */
+static int fileExists(char* path) {
+
+   FILE* file = fopen(path, "rb");
+
+   if(file == NULL) {
+      return 0;
+   }
+
+   fclose(file);
+
+   return 1;
+}
+
+/**
+ * \fn static void writeLevelResults(FILE* file, int level, char* session, Profile* profile, int diverged)
+ * \brief writes the results of a level as a JSON object
+ *
+ * \param[in] file: the JSON file
+ * \param[in] level: number of the level
+ * \param[in] session: path of the recording, or "scripted"
+ * \param[in] profile: the durations measured on the level
+ * \param[in] diverged: first frame where the replay diverged, -1 if it did not
+ */
+static void writeLevelResults(FILE* file, int level, char* session, Profile* profile, int diverged) {
+
+   ProfileStats stats;
+   int i;
+
+   fprintf(file, "    {\n");
+   fprintf(file, "      \"level\": %d,\n", level);
+   fprintf(file, "      \"session\": \"%s\",\n", session);
+   fprintf(file, "      \"frames\": %d,\n", profile->frameNumber);
+   fprintf(file, "      \"diverged_at\": %d,\n", diverged);
+   fprintf(file, "      \"load_game_ms\": %.4f,\n", profile->loadGame);
+   fprintf(file, "      \"load_map_ms\": %.4f,\n", profile->loadMap);
+   fprintf(file, "      \"sections_ms\": {\n");
+
+   for(i = 0; i < PROFILE_SECTION_NUMBER; i++) {
+
+      getProfileStats(profile, i, &stats);
+
+      fprintf(file, "        \"%s\": { \"mean\": %.4f, \"median\": %.4f, \"p95\": %.4f, \"p99\": %.4f, \"max\": %.4f }%s\n",
+              getProfileSectionName(i), stats.mean, stats.median, stats.p95, stats.p99, stats.max,
+              i < PROFILE_SECTION_NUMBER-1 ? "," : "");
+   }
+
+   fprintf(file, "      }\n");
+   fprintf(file, "    }");
+}
+
+/**
+ * \fn int runBenchmark(Game* game, char* path, int frameMax)
+ * \brief plays every level and writes the measured durations in a JSON file
+ *
+ * \param[in, out] game: the game, initialized in headless mode
+ * \param[in] path: path of the JSON file
+ * \param[in] frameMax: maximum number of frames per level, 0 for the whole session
+ *
+ * Returns 1 on success, 0 if the results can't be written or if a replay diverged.
+ */
+int runBenchmark(Game* game, char* path, int frameMax) {
+
+   FILE* file;
+   Profile* profile;
+   Replay* replay;
+   ProfileStats stats;
+   char map[200], session[200];
+   int level, frame, diverged, success = 1;
+
+   if((file = fopen(path, "w")) == NULL) {
+      fprintf(stderr, "can't write the benchmark results %s\n", path);
+      return 0;
+   }
+
+   fprintf(file, "{\n");
+   fprintf(file, "  \"levels\": [\n");
+
+   for(level = 0; ; level++) {
+
+      sprintf(map, "data/map/map%d.tmx", level);
+
+      if(!fileExists(map)) {
+         break;
+      }
+
+      profile = createProfile();
+      game->profile = profile;
+
+      /* loads the level */
+      game->level = level;
+      game->go = 1;
+      game->onMenu = 0;
+      initializePlayer(game->player, game);
+      loadGame(game);
+
+      /* recorded session if there is one */
+      sprintf(session, "data/replay/map%d.rpl", level);
+      replay = NULL;
+
+      if(fileExists(session) && (replay = loadReplay(session)) != NULL) {
+         startReplay(replay, game);
+      } else {
+         fprintf(stderr, "warning: can't play %s, level %d is benchmarked with a scripted session\n", session, level);
+         sprintf(session, "scripted");
+      }
+
+      diverged = -1;
+
+      for(frame = 0; game->go == 1 && (frameMax == 0 || frame < frameMax); frame++) {
+
+         startProfileFrame(profile);
+
+         if(replay != NULL) {
+            if(getReplayInput(replay, game->input) == 0) break;
+         } else {
+            if(frame == BENCH_FRAMES) break;
+            getScriptedInput(frame, game->input);
+         }
+
+         markProfile(profile, PROFILE_INPUT);
+
+         updateGame(game);
+
+         endProfileFrame(profile);
+
+         if(replay != NULL && diverged < 0 && checkReplayHash(replay, game) == 0) {
+            diverged = frame;
+            success = 0;
+         }
+      }
+
+      writeLevelResults(file, level, session, profile, diverged);
+
+      /* no comma after the last level */
+      sprintf(map, "data/map/map%d.tmx", level+1);
+      fprintf(file, fileExists(map) ? ",\n" : "\n");
+
+      getProfileStats(profile, PROFILE_FRAME, &stats);
+      printf("level %d (%s): %d frames, %.3f ms/frame, p99 %.3f ms, load %.3f ms%s\n",
+             level, session, profile->frameNumber, stats.mean, stats.p99, profile->loadGame,
+             diverged < 0 ? "" : ", replay diverged");
+
+      game->profile = NULL;
+      destroyProfile(profile);
+      destroyReplay(replay);
+   }
+
+   fprintf(file, "  ]\n");
+   fprintf(file, "}\n");
+
+   fclose(file);
+
+   return success;
+}
@@ -0,0 +1,21 @@
+/**
+ * \file bench.h
+ * \brief header of bench.c
+ *
+ * Declaration of runBenchmark().
+ *
+ * \author François-Xavier Balu, Gwendal Henry, Martin Parisot, Vincent Werner
+ */
+
+#ifndef BENCH_H_INCLUDED
+#define BENCH_H_INCLUDED
+
+#include "game.h"
+
+/* durée de la session scriptée quand un niveau n'a pas d'enregistrement */
+#define BENCH_FRAMES 1800
+
+int runBenchmark(Game* game, char* path, int frameMax);
+
+
+#endif // BENCH_H_INCLUDED
@@ -0,0 +1,643 @@
+/**
+ * \file blit.c
+ * \brief contains a faster blit for the pictures with an alpha channel
+ *
+ * Implementation of canAlphaBlit, alphaBlit, canCopyBlit, copyBlit, getBlitPath and checkBlit.
+ *
+ * SDL 1.2 blends a 32 bits picture with an alpha channel pixel by pixel. alphaBlit() does the
+ * same blending, giving exactly the same pixels as the C blitter of SDL (BlitRGBtoRGBPixelAlpha),
+ * but 8 pixels at a time with SSE2, or 16 with AVX2, chosen when the game runs according to the CPU.
+ * A group of fully transparent pixels is skipped, a group of opaque pixels is copied,
+ * only the other groups are blended.
+ *
+ * SDL computes the blending on packed pixels with 32 bits multiplications:
+ * red and blue together (mask 0xff00ff), then green (mask 0xff00). The SIMD code does the same
+ * computation on 32 bits lanes, overflows included, so no rounding differs.
+ *
+ * \author François-Xavier Balu, Gwendal Henry, Martin Parisot, Vincent Werner
+ */
+
+#include "blit.h"
+#include "draw.h"
+#include "profile.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define BLIT_SIMD
+#include <emmintrin.h>
+#include <immintrin.h>
+#endif
+
+
+/* fonctions de mélange d'une ligne, choisie au premier blit */
+typedef void (*BlendRow)(Uint32* src, Uint32* dst, int width);
+
+/* C, SSE2 et AVX2 */
+#define BLEND_ROW_MAX 3
+
+static BlendRow blendRow = NULL;
+static const char* blendName = "C";
+
+
+/**
+ * \fn static Uint32 blendPixel(Uint32 s, Uint32 d)
+ * \brief blends one pixel, as SDL's BlitRGBtoRGBPixelAlpha
+ */
+static Uint32 blendPixel(Uint32 s, Uint32 d) {
+
+   Uint32 alpha = s >> 24, s1, d1, dalpha;
+
+   if(alpha == 0) return d;
+
+   if(alpha == SDL_ALPHA_OPAQUE) return (s & 0x00ffffff) | (d & 0xff000000);
+
+   dalpha = d & 0xff000000;
+   s1 = s & 0xff00ff;
+   d1 = d & 0xff00ff;
+   d1 = (d1 + ((s1 - d1) * alpha >> 8)) & 0xff00ff;
+   s &= 0xff00;
+   d &= 0xff00;
+   d = (d + ((s - d) * alpha >> 8)) & 0xff00;
+
+   return d1 | d | dalpha;
+}
+
+/**
+ * \fn static void blendRowC(Uint32* src, Uint32* dst, int width)
+ * \brief blends a row of pixels, one at a time
+ */
+static void blendRowC(Uint32* src, Uint32* dst, int width) {
+
+   int x;
+
+   for(x = 0; x < width; x++) dst[x] = blendPixel(src[x], dst[x]);
+}
+
+#ifdef BLIT_SIMD
+
+/**
+ * \fn static __m128i mullo32(__m128i a, __m128i b)
+ * \brief 32 bits multiplication keeping the low 32 bits, SSE2 only has it for 64 bits lanes
+ */
+static __m128i mullo32(__m128i a, __m128i b) {
+
+   __m128i even = _mm_mul_epu32(a, b);
+   __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+
+   return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                             _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+/**
+ * \fn static __m128i blend4(__m128i s, __m128i d)
+ * \brief blends 4 pixels, with the computation of blendPixel()
+ */
+static __m128i blend4(__m128i s, __m128i d) {
+
+   const __m128i redBlue = _mm_set1_epi32(0xff00ff), green = _mm_set1_epi32(0xff00);
+   const __m128i alphaMask = _mm_set1_epi32(0xff000000), opaque = _mm_set1_epi32(0xff);
+   __m128i alpha = _mm_srli_epi32(s, 24);
+   __m128i s1, d1, s2, d2, blended, copied, isOpaque;
+
+   s1 = _mm_and_si128(s, redBlue);
+   d1 = _mm_and_si128(d, redBlue);
+   d1 = _mm_and_si128(_mm_add_epi32(d1, _mm_srli_epi32(mullo32(_mm_sub_epi32(s1, d1), alpha), 8)), redBlue);
+
+   s2 = _mm_and_si128(s, green);
+   d2 = _mm_and_si128(d, green);
+   d2 = _mm_and_si128(_mm_add_epi32(d2, _mm_srli_epi32(mullo32(_mm_sub_epi32(s2, d2), alpha), 8)), green);
+
+   blended = _mm_or_si128(_mm_or_si128(d1, d2), _mm_and_si128(d, alphaMask));
+
+   /* un pixel opaque est copié, en gardant l'alpha de la destination */
+   copied = _mm_or_si128(_mm_andnot_si128(alphaMask, s), _mm_and_si128(d, alphaMask));
+   isOpaque = _mm_cmpeq_epi32(alpha, opaque);
+
+   return _mm_or_si128(_mm_and_si128(isOpaque, copied), _mm_andnot_si128(isOpaque, blended));
+}
+
+/**
+ * \fn static void blendRowSSE2(Uint32* src, Uint32* dst, int width)
+ * \brief blends a row of pixels, 8 at a time
+ */
+static void blendRowSSE2(Uint32* src, Uint32* dst, int width) {
+
+   const __m128i alphaMask = _mm_set1_epi32(0xff000000);
+   __m128i s0, s1, d0, d1, a0, a1;
+   int x, transparent, opaque;
+
+   for(x = 0; x + 8 <= width; x += 8) {
+      s0 = _mm_loadu_si128((__m128i*)(src + x));
+      s1 = _mm_loadu_si128((__m128i*)(src + x + 4));
+
+      a0 = _mm_and_si128(s0, alphaMask);
+      a1 = _mm_and_si128(s1, alphaMask);
+
+      transparent = _mm_movemask_epi8(_mm_cmpeq_epi32(_mm_or_si128(a0, a1), _mm_setzero_si128()));
+
+      if(transparent == 0xffff) continue;
+
+      d0 = _mm_loadu_si128((__m128i*)(dst + x));
+      d1 = _mm_loadu_si128((__m128i*)(dst + x + 4));
+
+      opaque = _mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(a0, a1), alphaMask));
+
+      if(opaque == 0xffff) {
+         d0 = _mm_or_si128(_mm_andnot_si128(alphaMask, s0), _mm_and_si128(d0, alphaMask));
+         d1 = _mm_or_si128(_mm_andnot_si128(alphaMask, s1), _mm_and_si128(d1, alphaMask));
+      } else {
+         d0 = blend4(s0, d0);
+         d1 = blend4(s1, d1);
+      }
+
+      _mm_storeu_si128((__m128i*)(dst + x), d0);
+      _mm_storeu_si128((__m128i*)(dst + x + 4), d1);
+   }
+
+   blendRowC(src + x, dst + x, width - x);
+}
+
+/**
+ * \fn static __m256i blend8(__m256i s, __m256i d)
+ * \brief blends 8 pixels, with the computation of blendPixel()
+ */
+__attribute__((target("avx2")))
+static __m256i blend8(__m256i s, __m256i d) {
+
+   const __m256i redBlue = _mm256_set1_epi32(0xff00ff), green = _mm256_set1_epi32(0xff00);
+   const __m256i alphaMask = _mm256_set1_epi32(0xff000000), opaque = _mm256_set1_epi32(0xff);
+   __m256i alpha = _mm256_srli_epi32(s, 24);
+   __m256i s1, d1, s2, d2, blended, copied, isOpaque;
+
+   s1 = _mm256_and_si256(s, redBlue);
+   d1 = _mm256_and_si256(d, redBlue);
+   d1 = _mm256_and_si256(_mm256_add_epi32(d1, _mm256_srli_epi32(_mm256_mullo_epi32(_mm256_sub_epi32(s1, d1), alpha), 8)), redBlue);
+
+   s2 = _mm256_and_si256(s, green);
+   d2 = _mm256_and_si256(d, green);
+   d2 = _mm256_and_si256(_mm256_add_epi32(d2, _mm256_srli_epi32(_mm256_mullo_epi32(_mm256_sub_epi32(s2, d2), alpha), 8)), green);
+
+   blended = _mm256_or_si256(_mm256_or_si256(d1, d2), _mm256_and_si256(d, alphaMask));
+
+   copied = _mm256_or_si256(_mm256_andnot_si256(alphaMask, s), _mm256_and_si256(d, alphaMask));
+   isOpaque = _mm256_cmpeq_epi32(alpha, opaque);
+
+   return _mm256_blendv_epi8(blended, copied, isOpaque);
+}
+
+/**
+ * \fn static void blendRowAVX2(Uint32* src, Uint32* dst, int width)
+ * \brief blends a row of pixels, 16 at a time
+ */
+__attribute__((target("avx2")))
+static void blendRowAVX2(Uint32* src, Uint32* dst, int width) {
+
+   const __m256i alphaMask = _mm256_set1_epi32(0xff000000);
+   __m256i s0, s1, d0, d1, a0, a1;
+   int x;
+
+   for(x = 0; x + 16 <= width; x += 16) {
+      s0 = _mm256_loadu_si256((__m256i*)(src + x));
+      s1 = _mm256_loadu_si256((__m256i*)(src + x + 8));
+
+      a0 = _mm256_and_si256(s0, alphaMask);
+      a1 = _mm256_and_si256(s1, alphaMask);
+
+      if(_mm256_testz_si256(_mm256_or_si256(a0, a1), alphaMask)) continue;
+
+      d0 = _mm256_loadu_si256((__m256i*)(dst + x));
+      d1 = _mm256_loadu_si256((__m256i*)(dst + x + 8));
+
+      if(_mm256_movemask_epi8(_mm256_cmpeq_epi32(_mm256_and_si256(a0, a1), alphaMask)) == -1) {
+         d0 = _mm256_or_si256(_mm256_andnot_si256(alphaMask, s0), _mm256_and_si256(d0, alphaMask));
+         d1 = _mm256_or_si256(_mm256_andnot_si256(alphaMask, s1), _mm256_and_si256(d1, alphaMask));
+      } else {
+         d0 = blend8(s0, d0);
+         d1 = blend8(s1, d1);
+      }
+
+      _mm256_storeu_si256((__m256i*)(dst + x), d0);
+      _mm256_storeu_si256((__m256i*)(dst + x + 8), d1);
+   }
+
+   /* les derniers pixels d'une tile de 70 pixels */
+   blendRowSSE2(src + x, dst + x, width - x);
+}
+
+#endif
+
+/**
+ * \fn static int getBlendRows(BlendRow* rows, const char** names)
+ * \brief gives the blendings supported by the CPU, from the slowest to the fastest
+ *
+ * \param[out] rows: the functions, BLEND_ROW_MAX at most
+ * \param[out] names: their names
+ * \return the number of blendings
+ */
+static int getBlendRows(BlendRow* rows, const char** names) {
+
+   int number = 0;
+
+   rows[number] = blendRowC;
+   names[number++] = "C";
+
+#ifdef BLIT_SIMD
+   __builtin_cpu_init();
+
+   if(__builtin_cpu_supports("sse2")) {
+      rows[number] = blendRowSSE2;
+      names[number++] = "SSE2";
+   }
+
+   if(__builtin_cpu_supports("avx2")) {
+      rows[number] = blendRowAVX2;
+      names[number++] = "AVX2";
+   }
+#endif
+
+   return number;
+}
+
+/**
+ * \fn static void chooseBlendRow()
+ * \brief chooses the fastest blending supported by the CPU
+ */
+static void chooseBlendRow() {
+
+   BlendRow rows[BLEND_ROW_MAX];
+   const char* names[BLEND_ROW_MAX];
+   int number = getBlendRows(rows, names);
+
+   blendRow = rows[number - 1];
+   blendName = names[number - 1];
+}
+
+/**
+ * \fn int canAlphaBlit(SDL_Surface* src, SDL_Surface* dst)
+ * \brief tells if alphaBlit() can draw src on dst
+ *
+ * \param[in] src: the picture.
+ * \param[in] dst: the destination, usually the screen.
+ *
+ * The picture must be 32 bits with an alpha channel, blended (SDL_SRCALPHA), without color key,
+ * and the destination 32 bits with the same red, green and blue masks.
+ * Otherwise SDL_BlitSurface() has to be used.
+ */
+int canAlphaBlit(SDL_Surface* src, SDL_Surface* dst) {
+
+   SDL_PixelFormat *s = src->format, *d = dst->format;
+
+   return (src->flags & (SDL_SRCALPHA | SDL_SRCCOLORKEY | SDL_RLEACCEL)) == SDL_SRCALPHA
+          && s->BytesPerPixel == 4 && d->BytesPerPixel == 4
+          && s->Amask == 0xff000000 && s->Rmask == 0xff0000 && s->Gmask == 0xff00 && s->Bmask == 0xff
+          && d->Rmask == s->Rmask && d->Gmask == s->Gmask && d->Bmask == s->Bmask;
+}
+
+/**
+ * \fn static int clipBlit(SDL_Surface* src, SDL_Rect* srcRect, SDL_Surface* dst, SDL_Rect* dstRect, int* srcX, int* srcY)
+ * \brief clips the rectangles of a blit, as SDL_UpperBlit
+ *
+ * The source is clipped to the picture, then the destination to dst->clip_rect.
+ * The part drawn is written in dstRect (which must not be NULL) and its origin in the picture in srcX, srcY.
+ * Returns 0 if nothing has to be drawn.
+ */
+static int clipBlit(SDL_Surface* src, SDL_Rect* srcRect, SDL_Surface* dst, SDL_Rect* dstRect, int* srcX, int* srcY) {
+
+   SDL_Rect* clip = &(dst->clip_rect);
+   int x = 0, y = 0, dstX = dstRect->x, dstY = dstRect->y, w = src->w, h = src->h, d;
+
+   if(srcRect != NULL) {
+      x = srcRect->x;
+      y = srcRect->y;
+      w = srcRect->w;
+      h = srcRect->h;
+
+      if(x < 0) { w += x; dstX -= x; x = 0; }
+      if(y < 0) { h += y; dstY -= y; y = 0; }
+      if(src->w - x < w) w = src->w - x;
+      if(src->h - y < h) h = src->h - y;
+   }
+
+   if((d = clip->x - dstX) > 0) { w -= d; dstX += d; x += d; }
+   if((d = dstX + w - clip->x - clip->w) > 0) w -= d;
+   if((d = clip->y - dstY) > 0) { h -= d; dstY += d; y += d; }
+   if((d = dstY + h - clip->y - clip->h) > 0) h -= d;
+
+   if(w <= 0 || h <= 0) {
+      dstRect->w = dstRect->h = 0;
+
+      return 0;
+   }
+
+   dstRect->x = dstX;
+   dstRect->y = dstY;
+   dstRect->w = w;
+   dstRect->h = h;
+   *srcX = x;
+   *srcY = y;
+
+   return 1;
+}
+
+/**
+ * \fn int alphaBlit(SDL_Surface* src, SDL_Rect* srcRect, SDL_Surface* dst, SDL_Rect* dstRect)
+ * \brief draws a picture with an alpha channel, as SDL_BlitSurface()
+ *
+ * \param[in] src: the picture, canAlphaBlit() must be true.
+ * \param[in] srcRect: the part of the picture to draw, NULL for all of it.
+ * \param[in] dst: the destination.
+ * \param[in, out] dstRect: position on the destination, NULL for (0, 0).
+ *                          As with SDL_BlitSurface(), it is set to the part really drawn.
+ *
+ * The rectangles are clipped as SDL_BlitSurface() does. Returns 0.
+ */
+int alphaBlit(SDL_Surface* src, SDL_Rect* srcRect, SDL_Surface* dst, SDL_Rect* dstRect) {
+
+   SDL_Rect area = {0, 0, 0, 0};
+   Uint8 *srcRow, *dstRow;
+   int srcX, srcY, y, visible;
+
+   if(blendRow == NULL) chooseBlendRow();
+
+   if(dstRect != NULL) area = *dstRect;
+
+   visible = clipBlit(src, srcRect, dst, &area, &srcX, &srcY);
+
+   if(dstRect != NULL) *dstRect = area;
+
+   if(visible == 0) return 0;
+
+   if(SDL_MUSTLOCK(dst)) SDL_LockSurface(dst);
+
+   srcRow = (Uint8*)src->pixels + srcY * src->pitch + srcX * 4;
+   dstRow = (Uint8*)dst->pixels + area.y * dst->pitch + area.x * 4;
+
+   for(y = 0; y < area.h; y++) {
+      blendRow((Uint32*)srcRow, (Uint32*)dstRow, area.w);
+
+      srcRow += src->pitch;
+      dstRow += dst->pitch;
+   }
+
+   if(SDL_MUSTLOCK(dst)) SDL_UnlockSurface(dst);
+
+   return 0;
+}
+
+/**
+ * \fn int canCopyBlit(SDL_Surface* src, SDL_Surface* dst)
+ * \brief tells if copyBlit() can copy src on dst: both surfaces must have the same pixel format
+ */
+int canCopyBlit(SDL_Surface* src, SDL_Surface* dst) {
+
+   SDL_PixelFormat *s = src->format, *d = dst->format;
+
+   return (src->flags & SDL_RLEACCEL) == 0 && s->BytesPerPixel == d->BytesPerPixel && s->BytesPerPixel > 1
+          && s->Rmask == d->Rmask && s->Gmask == d->Gmask && s->Bmask == d->Bmask && s->Amask == d->Amask;
+}
+
+/**
+ * \fn int copyBlit(SDL_Surface* src, SDL_Rect* srcRect, SDL_Surface* dst, SDL_Rect* dstRect)
+ * \brief copies a part of a picture, alpha channel included, without blending
+ *
+ * \param[in] src: the picture, canCopyBlit() must be true.
+ * \param[in] srcRect: the part of the picture to copy, NULL for all of it.
+ * \param[in] dst: the destination.
+ * \param[in, out] dstRect: position on the destination, NULL for (0, 0). Set to the part really copied.
+ *
+ * Returns 0.
+ */
+int copyBlit(SDL_Surface* src, SDL_Rect* srcRect, SDL_Surface* dst, SDL_Rect* dstRect) {
+
+   SDL_Rect area = {0, 0, 0, 0};
+   Uint8 *srcRow, *dstRow;
+   int srcX, srcY, y, visible, bpp = src->format->BytesPerPixel;
+
+   if(dstRect != NULL) area = *dstRect;
+
+   visible = clipBlit(src, srcRect, dst, &area, &srcX, &srcY);
+
+   if(dstRect != NULL) *dstRect = area;
+
+   if(visible == 0) return 0;
+
+   if(SDL_MUSTLOCK(dst)) SDL_LockSurface(dst);
+
+   srcRow = (Uint8*)src->pixels + srcY * src->pitch + srcX * bpp;
+   dstRow = (Uint8*)dst->pixels + area.y * dst->pitch + area.x * bpp;
+
+   for(y = 0; y < area.h; y++) {
+      memcpy(dstRow, srcRow, area.w * bpp);
+
+      srcRow += src->pitch;
+      dstRow += dst->pitch;
+   }
+
+   if(SDL_MUSTLOCK(dst)) SDL_UnlockSurface(dst);
+
+   return 0;
+}
+
+/**
+ * \fn const char* getBlitPath()
+ * \brief name of the blending used by alphaBlit(): "AVX2", "SSE2" or "C"
+ */
+const char* getBlitPath() {
+
+   if(blendRow == NULL) chooseBlendRow();
+
+   return blendName;
+}
+
+/**
+ * \fn static int comparePictures(SDL_Surface* a, SDL_Surface* b)
+ * \brief counts the pixels differing between two surfaces of the same size
+ */
+static int comparePictures(SDL_Surface* a, SDL_Surface* b) {
+
+   int x, y, differences = 0;
+
+   for(y = 0; y < a->h; y++) {
+      Uint32* rowA = (Uint32*)((Uint8*)a->pixels + y * a->pitch);
+      Uint32* rowB = (Uint32*)((Uint8*)b->pixels + y * b->pitch);
+
+      for(x = 0; x < a->w; x++) {
+         if(rowA[x] != rowB[x]) differences++;
+      }
+   }
+
+   return differences;
+}
+
+/**
+ * \fn static void fillNoise(SDL_Surface* surface, Uint32 seed)
+ * \brief fills a surface with pseudo-random pixels
+ */
+static void fillNoise(SDL_Surface* surface, Uint32 seed) {
+
+   int x, y;
+
+   for(y = 0; y < surface->h; y++) {
+      Uint32* row = (Uint32*)((Uint8*)surface->pixels + y * surface->pitch);
+
+      for(x = 0; x < surface->w; x++) {
+         seed = seed * 1664525 + 1013904223;
+         row[x] = seed;
+      }
+   }
+}
+
+/**
+ * \fn static int comparePaths(SDL_Surface* expected, SDL_Surface* result, int verbose)
+ * \brief draws the pictures of the game with SDL_BlitSurface() and alphaBlit(), and counts the different pixels
+ *
+ * The pictures are drawn at positions partly out of the screen, on surfaces filled with noise.
+ * With verbose, the result of each picture is printed.
+ */
+static int comparePaths(SDL_Surface* expected, SDL_Surface* result, int verbose) {
+
+   char* files[] = {
+      "data/graphics/all_tileset.png", "data/graphics/walkright.png", "data/graphics/flyleft.png",
+      "data/graphics/hud_coins.png", "data/graphics/backgroundworld1.png", "data/graphics/spriteSheetMenu.png"
+   };
+   int positions[][2] = { {0, 0}, {13, 7}, {-31, -5}, {SCREEN_WIDTH - 40, SCREEN_HEIGHT - 33}, {-100, 300} };
+   SDL_Surface* image;
+   SDL_Rect src, dest, destCopy;
+   int i, j, differences, total = 0;
+
+   for(i = 0; i < (int)(sizeof(files) / sizeof(files[0])); i++) {
+      if((image = loadImage(files[i])) == NULL) continue;
+
+      differences = 0;
+
+      if(canAlphaBlit(image, expected) == 0) {
+         if(verbose) printf("%s: not handled by alphaBlit()\n", files[i]);
+         releaseImage(image);
+
+         continue;
+      }
+
+      for(j = 0; j < (int)(sizeof(positions) / sizeof(positions[0])); j++) {
+         fillNoise(expected, 12345 + j);
+         fillNoise(result, 12345 + j);
+
+         /* une partie de l'image, décalée, et l'image entière */
+         src.x = j * 7 - 10;
+         src.y = j * 3;
+         src.w = image->w / 2 + j * 11;
+         src.h = image->h / 2 + 5;
+
+         dest.x = positions[j][0];
+         dest.y = positions[j][1];
+         destCopy = dest;
+
+         SDL_BlitSurface(image, &src, expected, &dest);
+         alphaBlit(image, &src, result, &destCopy);
+
+         SDL_BlitSurface(image, NULL, expected, NULL);
+         alphaBlit(image, NULL, result, NULL);
+
+         differences += comparePictures(expected, result);
+
+         if(dest.x != destCopy.x || dest.y != destCopy.y || dest.w != destCopy.w || dest.h != destCopy.h) {
+            printf("%s: clipped rectangles differ at position %d\n", files[i], j);
+            differences++;
+         }
+      }
+
+      if(verbose || differences > 0) printf("%s (%s): %d different pixels\n", files[i], blendName, differences);
+      total += differences;
+
+      releaseImage(image);
+   }
+
+   return total;
+}
+
+/**
+ * \fn int checkBlit(int verbose)
+ * \brief checks that alphaBlit() gives the same pixels as SDL_BlitSurface(), and compares their speed
+ *
+ * \param[in] verbose: 1 to print the result of each picture and to compare the speed (--check-blit),
+ *                     0 to print only the differences (check at the start of a headless run)
+ *
+ * The pictures of the game are drawn with both blits, with each blending supported by the CPU (C, SSE2, AVX2).
+ * Then every tile of the tileset is drawn BLIT_CHECK_TILES times with each blit.
+ * The screen must have been created (initGame()).
+ * Returns 1 if every pixel is the same, 0 otherwise.
+ */
+int checkBlit(int verbose) {
+
+   SDL_Surface *screen = SDL_GetVideoSurface(), *expected, *result, *tileset;
+   SDL_Rect src, dest;
+   BlendRow rows[BLEND_ROW_MAX], chosenRow;
+   const char *names[BLEND_ROW_MAX], *chosenName;
+   int i, j, number, total = 0;
+   double start, sdlTime = 0, blitTime = 0;
+
+   if(screen == NULL) return 0;
+
+   expected = SDL_DisplayFormat(screen);
+   result = SDL_DisplayFormat(screen);
+
+   if(expected == NULL || result == NULL) {
+      printf("Couldn't create the surfaces to compare: %s\n", SDL_GetError());
+      SDL_FreeSurface(expected);
+      SDL_FreeSurface(result);
+
+      return 0;
+   }
+
+   if(blendRow == NULL) chooseBlendRow();
+
+   if(verbose) printf("blit: %s\n", blendName);
+
+   /* chaque mélange, puis celui choisi pour le jeu */
+   chosenRow = blendRow;
+   chosenName = blendName;
+   number = getBlendRows(rows, names);
+
+   for(i = 0; i < number; i++) {
+      blendRow = rows[i];
+      blendName = names[i];
+
+      total += comparePaths(expected, result, verbose);
+   }
+
+   blendRow = chosenRow;
+   blendName = chosenName;
+
+   /* vitesse sur les tiles de 70 x 70 */
+   if(verbose && (tileset = loadImage("data/graphics/all_tileset.png")) != NULL) {
+      if(canAlphaBlit(tileset, result)) {
+         src.w = src.h = TILE_SIZE;
+
+         for(j = 0; j < 2; j++) {
+            start = getTime();
+
+            for(i = 0; i < BLIT_CHECK_TILES; i++) {
+               src.x = (i % (tileset->w / TILE_SIZE)) * TILE_SIZE;
+               src.y = (i / (tileset->w / TILE_SIZE) % (tileset->h / TILE_SIZE)) * TILE_SIZE;
+               dest.x = (i * TILE_SIZE) % (SCREEN_WIDTH - TILE_SIZE);
+               dest.y = (i % 9) * TILE_SIZE;
+
+               if(j == 0) SDL_BlitSurface(tileset, &src, expected, &dest);
+               else alphaBlit(tileset, &src, result, &dest);
+            }
+
+            if(j == 0) sdlTime = getTime() - start;
+            else blitTime = getTime() - start;
+         }
+
+         printf("%d tiles: SDL_BlitSurface %.3f ms, alphaBlit %.3f ms\n", BLIT_CHECK_TILES, sdlTime, blitTime);
+      }
+
+      releaseImage(tileset);
+   }
+
+   SDL_FreeSurface(expected);
+   SDL_FreeSurface(result);
+
+   if(verbose || total > 0) printf("%s\n", total == 0 ? "alphaBlit is exact" : "alphaBlit differs from SDL_BlitSurface");
+
+   return total == 0;
+}
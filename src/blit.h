@@ -0,0 +1,27 @@
+/**
+ * \file blit.h
+ * \brief header of blit.c
+ *
+ * Declaration of canAlphaBlit(), alphaBlit(), canCopyBlit(), copyBlit(), getBlitPath() and checkBlit().
+ *
+ * \author François-Xavier Balu, Gwendal Henry, Martin Parisot, Vincent Werner
+ */
+
+#ifndef BLIT_H_INCLUDED
+#define BLIT_H_INCLUDED
+
+#include "common.h"
+
+/* nombre de blits de tiles mesurés par checkBlit() */
+#define BLIT_CHECK_TILES 20000
+
+
+int canAlphaBlit(SDL_Surface* src, SDL_Surface* dst);
+int alphaBlit(SDL_Surface* src, SDL_Rect* srcRect, SDL_Surface* dst, SDL_Rect* dstRect);
+int canCopyBlit(SDL_Surface* src, SDL_Surface* dst);
+int copyBlit(SDL_Surface* src, SDL_Rect* srcRect, SDL_Surface* dst, SDL_Rect* dstRect);
+const char* getBlitPath();
+int checkBlit(int verbose);
+
+
+#endif // BLIT_H_INCLUDED
@@ -0,0 +1,561 @@
+/**
+ * \file chunk.c
+ * \brief contains the tiles of the level around the camera and their solidity, copied from the cooked level by chunks
+ *
+ * Implementation of createChunkStream, startChunkStream, stopChunkStream, streamChunks, getTile,
+ * getSolidity, getTileSpans and destroyChunkStream.
+ *
+ * The tiles of a level are cut in chunks of CHUNK_SIZE x CHUNK_SIZE tiles. Only the chunks around the camera
+ * are in memory, in CHUNK_SLOTS places allocated once: the cooked level (levelfile.h) is mapped in memory and
+ * its pages are only read from the disk when a chunk is copied, so the memory used doesn't depend on the size of the level.
+ * Each frame, streamChunks() asks a thread to read the chunks which are CHUNK_MARGIN chunks around the screen,
+ * and gives back the places of the chunks more than CHUNK_KEEP chunks away. A tile asked before its chunk
+ * is read (the first frame of a level, or a camera faster than the thread) is read at once by the main thread.
+ *
+ * The main thread only reads a chunk once it has seen it ready with the mutex, and the thread
+ * never takes a place which isn't free: the tiles are read without locking.
+ *
+ * \author François-Xavier Balu, Gwendal Henry, Martin Parisot, Vincent Werner
+ */
+
+#include "chunk.h"
+#include "map.h"
+#include "arena.h"
+
+
+/**
+ * \fn static int isEmptyTile(Map* map, int gid)
+ * \brief tells if a tile draws nothing: gid 0 or a transparent tile of the tileset
+ */
+static int isEmptyTile(Map* map, int gid) {
+
+   return gid <= 0 || (gid - 1 < map->tileNumber && map->tileOpacity[gid - 1] == TILE_TRANSPARENT);
+}
+
+/**
+ * \fn static void decodeChunk(ChunkStream* stream, TileChunk* chunk)
+ * \brief Copy the tiles of chunk->index and their solidity from the cooked level, then find the groups of consecutive non-empty tiles of each row
+ *
+ * \param[in] stream
+ * \param[out] chunk: the place of the chunk ; the tiles outside the map are 0
+ */
+static void decodeChunk(ChunkStream* stream, TileChunk* chunk) {
+
+   Map* map = stream->map;
+   const Sint32* tiles = stream->level->tiles + chunk->index * CHUNK_SIZE * CHUNK_SIZE;
+   int x, y, number = 0;
+
+   for(x = 0; x < CHUNK_SIZE * CHUNK_SIZE; x++) chunk->tile[x] = tiles[x];
+
+   memcpy(chunk->solid, stream->level->solid + chunk->index * CHUNK_SIZE * CHUNK_SIZE, CHUNK_SIZE * CHUNK_SIZE);
+
+   for(y = 0; y < CHUNK_SIZE; y++) {
+      chunk->rowSpans[y] = number;
+
+      for(x = 0; x < CHUNK_SIZE; x++) {
+         if(isEmptyTile(map, chunk->tile[y * CHUNK_SIZE + x])) continue;
+
+         chunk->spans[number].start = x;
+
+         while(x < CHUNK_SIZE && isEmptyTile(map, chunk->tile[y * CHUNK_SIZE + x]) == 0) x++;
+
+         chunk->spans[number].end = x;
+         number++;
+      }
+   }
+
+   chunk->rowSpans[CHUNK_SIZE] = number;
+}
+
+/**
+ * \fn static void releaseSlot(ChunkStream* stream, TileChunk* chunk)
+ * \brief Give back the place of a ready chunk ; only the main thread does it, with the mutex
+ */
+static void releaseSlot(ChunkStream* stream, TileChunk* chunk) {
+
+   stream->resident[chunk->index] = NULL;
+   stream->slot[chunk->index] = -1;
+
+   chunk->index = -1;
+   chunk->state = CHUNK_FREE;
+}
+
+/**
+ * \fn static TileChunk* takeSlot(ChunkStream* stream, int index, int evict)
+ * \brief Take a place for the chunk index, which isn't in any place, with the mutex
+ *
+ * \param[in, out] stream
+ * \param[in] index: the chunk, its place is then CHUNK_LOADING
+ * \param[in] evict: 1 for the main thread, which can give back the ready chunk used the longest time ago
+ * \return the place, NULL if none is free and evict is 0
+ */
+static TileChunk* takeSlot(ChunkStream* stream, int index, int evict) {
+
+   TileChunk *chunk = NULL, *oldest = NULL;
+   int i;
+
+   for(i = 0; i < CHUNK_SLOTS && chunk == NULL; i++) {
+
+      if(stream->slots[i].state == CHUNK_FREE) chunk = &stream->slots[i];
+
+      else if(stream->slots[i].state == CHUNK_READY && (oldest == NULL || stream->slots[i].used < oldest->used)) oldest = &stream->slots[i];
+   }
+
+   if(chunk == NULL) {
+      if(evict == 0 || oldest == NULL) return NULL;
+
+      releaseSlot(stream, oldest);
+      chunk = oldest;
+   }
+
+   chunk->index = index;
+   chunk->state = CHUNK_LOADING;
+   stream->slot[index] = chunk - stream->slots;
+
+   return chunk;
+}
+
+/**
+ * \fn static int chunkThread(void* data)
+ * \brief Read the chunks asked by streamChunks(), until destroyChunkStream()
+ *
+ * \param[in, out] data: the ChunkStream structure
+ */
+static int chunkThread(void* data) {
+
+   ChunkStream* stream = (ChunkStream*)data;
+   TileChunk* chunk;
+   int index;
+
+   SDL_mutexP(stream->mutex);
+
+   for(;;) {
+
+      while(stream->queueNumber == 0 && stream->quit == 0) SDL_CondWait(stream->condition, stream->mutex);
+
+      if(stream->quit) break;
+
+      index = stream->queue[stream->queueFirst];
+      stream->queueFirst = (stream->queueFirst + 1) % CHUNK_QUEUE;
+      stream->queueNumber--;
+      stream->requested[index] = 0;
+
+      /* déjà lu par le thread principal, ou plus de place : il sera demandé à nouveau s'il le faut */
+      if(stream->slot[index] != -1 || (chunk = takeSlot(stream, index, 0)) == NULL) continue;
+
+      stream->busy = 1;
+      SDL_mutexV(stream->mutex);
+
+      decodeChunk(stream, chunk);
+
+      SDL_mutexP(stream->mutex);
+      chunk->state = CHUNK_READY;
+      stream->busy = 0;
+      SDL_CondBroadcast(stream->condition);
+   }
+
+   SDL_mutexV(stream->mutex);
+
+   return 0;
+}
+
+/**
+ * \fn static TileChunk* loadChunk(ChunkStream* stream, int index)
+ * \brief Give a chunk which isn't in stream->resident yet, reading it at once if needed
+ *
+ * \param[in, out] stream
+ * \param[in] index: the chunk
+ * \return its place, ready
+ *
+ * If the thread is reading it, the main thread waits for it instead of reading it again.
+ */
+static TileChunk* loadChunk(ChunkStream* stream, int index) {
+
+   TileChunk* chunk;
+
+   SDL_mutexP(stream->mutex);
+
+   if(stream->slot[index] != -1) {
+      chunk = &stream->slots[stream->slot[index]];
+
+      while(chunk->state != CHUNK_READY) SDL_CondWait(stream->condition, stream->mutex);
+   }
+   else {
+      chunk = takeSlot(stream, index, 1);
+
+      SDL_mutexV(stream->mutex);
+
+      decodeChunk(stream, chunk);
+
+      SDL_mutexP(stream->mutex);
+      chunk->state = CHUNK_READY;
+   }
+
+   chunk->used = stream->frame;
+   stream->resident[index] = chunk;
+
+   SDL_mutexV(stream->mutex);
+
+   return chunk;
+}
+
+/**
+ * \fn static int clampChunk(int position, int number)
+ * \brief Give the chunk of a position in pixels, the nearest one of the map when the position is outside
+ */
+static int clampChunk(int position, int number) {
+
+   int chunk = position < 0 ? 0 : position / (TILE_SIZE * CHUNK_SIZE);
+
+   return chunk < number ? chunk : number - 1;
+}
+
+/**
+ * \fn static int requestChunks(ChunkStream* stream, int x0, int y0, int x1, int y1)
+ * \brief Ask the thread for the chunks of a rectangle which aren't loaded, with the mutex
+ * \return the number of chunks asked
+ */
+static int requestChunks(ChunkStream* stream, int x0, int y0, int x1, int y1) {
+
+   int x, y, index, number = 0;
+
+   if(x0 < 0) x0 = 0;
+   if(y0 < 0) y0 = 0;
+   if(x1 >= stream->columns) x1 = stream->columns - 1;
+   if(y1 >= stream->rows) y1 = stream->rows - 1;
+
+   for(y = y0; y <= y1; y++) {
+      for(x = x0; x <= x1; x++) {
+
+         index = y * stream->columns + x;
+
+         if(stream->slot[index] != -1 || stream->requested[index] || stream->queueNumber == CHUNK_QUEUE) continue;
+
+         stream->queue[(stream->queueFirst + stream->queueNumber) % CHUNK_QUEUE] = index;
+         stream->queueNumber++;
+         stream->requested[index] = 1;
+         number++;
+      }
+   }
+
+   return number;
+}
+
+/**
+ * \fn ChunkStream* createChunkStream(Map* map)
+ * \brief Create the ChunkStream structure, with its places and its thread
+ *
+ * \param[in] map: the map whose tiles are read, its levels are given by startChunkStream()
+ * \return the ChunkStream structure, NULL if the allocation failed
+ *
+ * If the thread can't be started, every chunk is read by the main thread when it is needed.
+ */
+ChunkStream* createChunkStream(Map* map) {
+
+   ChunkStream* stream;
+   int i;
+
+   if((stream = (ChunkStream*)malloc(sizeof(ChunkStream))) == NULL) {
+      fprintf(stderr, "can't allocate memory for a ChunkStream\n");
+
+      return NULL;
+   }
+
+   if((stream->slots = (TileChunk*)malloc(CHUNK_SLOTS * sizeof(TileChunk))) == NULL) {
+      fprintf(stderr, "can't allocate memory for the chunks of the tiles\n");
+      free(stream);
+
+      return NULL;
+   }
+
+   for(i = 0; i < CHUNK_SLOTS; i++) {
+      stream->slots[i].index = -1;
+      stream->slots[i].state = CHUNK_FREE;
+      stream->slots[i].used = 0;
+   }
+
+   stream->map = map;
+   stream->level = NULL;
+   stream->columns = stream->rows = 0;
+   stream->slot = NULL;
+   stream->requested = NULL;
+   stream->resident = NULL;
+   stream->frame = 0;
+   stream->queueFirst = stream->queueNumber = 0;
+   stream->busy = 0;
+   stream->quit = 0;
+   stream->thread = NULL;
+
+   stream->mutex = SDL_CreateMutex();
+   stream->condition = SDL_CreateCond();
+
+   if(stream->mutex != NULL && stream->condition != NULL) {
+      stream->thread = SDL_CreateThread(chunkThread, stream);
+   }
+
+   if(stream->thread == NULL) {
+      fprintf(stderr, "Couldn't start the thread reading the chunks: %s\n", SDL_GetError());
+
+      if(stream->mutex == NULL || stream->condition == NULL) {
+         destroyChunkStream(stream);
+
+         return NULL;
+      }
+   }
+
+   return stream;
+}
+
+/**
+ * \fn int startChunkStream(ChunkStream* stream, const LevelFile* level)
+ * \brief Give the level whose chunks are read, after stopChunkStream()
+ *
+ * \param[in, out] stream
+ * \param[in] level: the cooked level, open until the next stopChunkStream()
+ * \return 0 if the tables of the chunks couldn't be allocated in the arena of the map
+ *
+ * The size of the level must be in the map. No chunk is loaded yet.
+ */
+int startChunkStream(ChunkStream* stream, const LevelFile* level) {
+
+   Map* map = stream->map;
+   int i, columns, rows;
+
+   columns = (map->sizeX + CHUNK_SIZE - 1) / CHUNK_SIZE;
+   rows = (map->sizeY + CHUNK_SIZE - 1) / CHUNK_SIZE;
+
+   stream->slot = (int*)arenaAlloc(map->arena, (columns * rows + 1) * sizeof(int));
+   stream->requested = (unsigned char*)arenaAlloc(map->arena, columns * rows + 1);
+   stream->resident = (TileChunk**)arenaAlloc(map->arena, (columns * rows + 1) * sizeof(TileChunk*));
+
+   if(stream->slot == NULL || stream->requested == NULL || stream->resident == NULL) {
+      fprintf(stderr, "can't allocate memory for the chunks of the level\n");
+
+      return 0;
+   }
+
+   for(i = 0; i < columns * rows; i++) {
+      stream->slot[i] = -1;
+      stream->requested[i] = 0;
+      stream->resident[i] = NULL;
+   }
+
+   SDL_mutexP(stream->mutex);
+
+   stream->level = level;
+   stream->columns = columns;
+   stream->rows = rows;
+
+   SDL_mutexV(stream->mutex);
+
+   return 1;
+}
+
+/**
+ * \fn void stopChunkStream(ChunkStream* stream)
+ * \brief Forget the chunks of the level, before the arena of the map is reset and the cooked level closed
+ *
+ * The chunks asked to the thread are forgotten, and the chunk it is reading is waited for.
+ */
+void stopChunkStream(ChunkStream* stream) {
+
+   int i;
+
+   SDL_mutexP(stream->mutex);
+
+   stream->queueNumber = 0;
+
+   while(stream->busy) SDL_CondWait(stream->condition, stream->mutex);
+
+   for(i = 0; i < CHUNK_SLOTS; i++) {
+      stream->slots[i].index = -1;
+      stream->slots[i].state = CHUNK_FREE;
+   }
+
+   stream->level = NULL;
+   stream->slot = NULL;
+   stream->requested = NULL;
+   stream->resident = NULL;
+   stream->columns = stream->rows = 0;
+
+   SDL_mutexV(stream->mutex);
+}
+
+/**
+ * \fn void streamChunks(Map* map)
+ * \brief Ask for the chunks around the camera and give back the places of the far ones, once per frame
+ *
+ * \param[in, out] map: the map, with the camera of the frame (startX, startY)
+ */
+void streamChunks(Map* map) {
+
+   ChunkStream* stream = map->chunks;
+   TileChunk* chunk;
+   int i, cx, cy, x0, y0, x1, y1, number;
+
+   if(stream->columns == 0) return;
+
+   stream->frame++;
+
+   /* chunks de l'écran */
+   x0 = clampChunk(map->startX, stream->columns);
+   x1 = clampChunk(map->startX + SCREEN_WIDTH - 1, stream->columns);
+   y0 = clampChunk(map->startY, stream->rows);
+   y1 = clampChunk(map->startY + SCREEN_HEIGHT - 1, stream->rows);
+
+   SDL_mutexP(stream->mutex);
+
+   for(i = 0; i < CHUNK_SLOTS; i++) {
+
+      chunk = &stream->slots[i];
+
+      if(chunk->state != CHUNK_READY) continue;
+
+      cx = chunk->index % stream->columns;
+      cy = chunk->index / stream->columns;
+
+      /* loin de la caméra : la place est rendue */
+      if(cx < x0 - CHUNK_KEEP || cx > x1 + CHUNK_KEEP || cy < y0 - CHUNK_KEEP || cy > y1 + CHUNK_KEEP) {
+         releaseSlot(stream, chunk);
+         continue;
+      }
+
+      /* lu par le thread depuis la dernière frame : le thread principal peut maintenant le lire sans verrou */
+      stream->resident[chunk->index] = chunk;
+      chunk->used = stream->frame;
+   }
+
+   if(stream->thread != NULL) {
+
+      /* ceux de l'écran d'abord */
+      number = requestChunks(stream, x0, y0, x1, y1);
+      number += requestChunks(stream, x0 - CHUNK_MARGIN, y0 - CHUNK_MARGIN, x1 + CHUNK_MARGIN, y1 + CHUNK_MARGIN);
+
+      if(number > 0) SDL_CondBroadcast(stream->condition);
+   }
+
+   SDL_mutexV(stream->mutex);
+}
+
+/**
+ * \fn int getTile(Map* map, int x, int y)
+ * \brief Give the tile of a column and a row of the map, 0 outside the map
+ *
+ * The chunk of the tile is read at once if it isn't loaded.
+ */
+int getTile(Map* map, int x, int y) {
+
+   ChunkStream* stream = map->chunks;
+   TileChunk* chunk;
+   int index;
+
+   if(x < 0 || y < 0 || x >= map->sizeX || y >= map->sizeY) return 0;
+
+   index = (y / CHUNK_SIZE) * stream->columns + x / CHUNK_SIZE;
+
+   if((chunk = stream->resident[index]) == NULL) chunk = loadChunk(stream, index);
+
+   return chunk->tile[(y % CHUNK_SIZE) * CHUNK_SIZE + x % CHUNK_SIZE];
+}
+
+/**
+ * \fn int getSolidity(Map* map, int x, int y)
+ * \brief Give 1 if the tile of a column and a row of the map is solid, without the blocks ; 0 outside the map
+ *
+ * The monsters move everywhere: when the chunk isn't loaded, the byte is read in the cooked level,
+ * whose solidity is stored by chunk too, instead of taking the place of a chunk around the camera.
+ */
+int getSolidity(Map* map, int x, int y) {
+
+   ChunkStream* stream = map->chunks;
+   TileChunk* chunk;
+   int index, i;
+
+   if(x < 0 || y < 0 || x >= map->sizeX || y >= map->sizeY) return 0;
+
+   index = (y / CHUNK_SIZE) * stream->columns + x / CHUNK_SIZE;
+   i = (y % CHUNK_SIZE) * CHUNK_SIZE + x % CHUNK_SIZE;
+
+   if((chunk = stream->resident[index]) == NULL) return stream->level->solid[index * CHUNK_SIZE * CHUNK_SIZE + i];
+
+   return chunk->solid[i];
+}
+
+/**
+ * \fn int getTileSpans(Map* map, int y, int x1, int x2, TileSpan* spans, int size)
+ * \brief Give the groups of consecutive non-empty tiles of the row y, between the columns x1 and x2 - 1
+ *
+ * \param[in] map
+ * \param[in] y: the row
+ * \param[in] x1, x2: the columns, the spans are cut to them
+ * \param[out] spans: the spans, sorted
+ * \param[in] size: size of spans ; (x2 - x1 + 1) / 2 spans at most are found
+ * \return the number of spans
+ *
+ * drawMap(), drawBackground() and the scroll cache only go through these spans,
+ * so the empty parts of a level cost nothing. The spans cut by the border of a chunk are joined again.
+ */
+int getTileSpans(Map* map, int y, int x1, int x2, TileSpan* spans, int size) {
+
+   ChunkStream* stream = map->chunks;
+   TileChunk* chunk;
+   int i, cx, row, index, start, end, number = 0;
+
+   if(y < 0 || y >= map->sizeY) return 0;
+
+   if(x1 < 0) x1 = 0;
+   if(x2 > map->sizeX) x2 = map->sizeX;
+
+   row = y % CHUNK_SIZE;
+
+   for(cx = x1 / CHUNK_SIZE; cx * CHUNK_SIZE < x2; cx++) {
+
+      index = (y / CHUNK_SIZE) * stream->columns + cx;
+
+      if((chunk = stream->resident[index]) == NULL) chunk = loadChunk(stream, index);
+
+      for(i = chunk->rowSpans[row]; i < chunk->rowSpans[row + 1]; i++) {
+
+         start = cx * CHUNK_SIZE + chunk->spans[i].start;
+         end = cx * CHUNK_SIZE + chunk->spans[i].end;
+
+         if(start < x1) start = x1;
+         if(end > x2) end = x2;
+
+         if(start >= end) continue;
+
+         if(number > 0 && spans[number - 1].end == start) spans[number - 1].end = end;
+
+         else if(number < size) {
+            spans[number].start = start;
+            spans[number].end = end;
+            number++;
+         }
+      }
+   }
+
+   return number;
+}
+
+/**
+ * \fn void destroyChunkStream(ChunkStream* stream)
+ * \brief Stop the thread, then free the ChunkStream structure and its places
+ */
+void destroyChunkStream(ChunkStream* stream) {
+
+   if(stream == NULL) return;
+
+   if(stream->thread != NULL) {
+      SDL_mutexP(stream->mutex);
+      stream->quit = 1;
+      SDL_CondBroadcast(stream->condition);
+      SDL_mutexV(stream->mutex);
+
+      SDL_WaitThread(stream->thread, NULL);
+   }
+
+   SDL_DestroyCond(stream->condition);
+   SDL_DestroyMutex(stream->mutex);
+   free(stream->slots);
+   free(stream);
+}
@@ -0,0 +1,102 @@
+/**
+ * \file chunk.h
+ * \brief header of chunk.c
+ *
+ * Creation of the TileChunk and ChunkStream structures.
+ * Declaration of createChunkStream(), startChunkStream(), stopChunkStream(), streamChunks(), getTile(),
+ * getSolidity(), getTileSpans() and destroyChunkStream().
+ *
+ * \author François-Xavier Balu, Gwendal Henry, Martin Parisot, Vincent Werner
+ */
+
+#ifndef CHUNK_H_INCLUDED
+#define CHUNK_H_INCLUDED
+
+#include "game.h"
+#include "levelfile.h"
+#include <SDL_thread.h>
+
+/* côté d'un chunk, en tiles */
+#define CHUNK_SIZE 32
+
+/* chunks lus d'avance autour de ceux de l'écran, et chunks gardés avant d'être rendus */
+#define CHUNK_MARGIN 1
+#define CHUNK_KEEP 2
+
+/* places de chunk : assez pour tous les chunks gardés autour de l'écran */
+#define CHUNK_SLOTS 36
+
+/* chunks demandés au thread et pas encore lus */
+#define CHUNK_QUEUE (2 * CHUNK_SLOTS)
+
+/* état d'une place */
+enum{CHUNK_FREE, CHUNK_LOADING, CHUNK_READY};
+
+
+typedef struct TileChunk{
+
+    /* chunk de la map dans cette place (cy * columns + cx), et son état (CHUNK_*) */
+    int index;
+    int state;
+
+    /* dernière frame où il était autour de l'écran, la place la plus ancienne est reprise en premier */
+    unsigned int used;
+
+    int tile[CHUNK_SIZE * CHUNK_SIZE];
+
+    /* 1 pour une tile solide, sans les blocs (Map.blockSolid) */
+    unsigned char solid[CHUNK_SIZE * CHUNK_SIZE];
+
+    /* tiles non vides : les spans de la ligne y vont de spans[rowSpans[y]] à spans[rowSpans[y + 1] - 1],
+       en colonnes du chunk */
+    int rowSpans[CHUNK_SIZE + 1];
+    TileSpan spans[CHUNK_SIZE * CHUNK_SIZE / 2];
+
+}TileChunk;
+
+
+typedef struct ChunkStream{
+
+    struct Map *map;
+
+    /* niveau cuit d'où les tiles et leur solidité sont copiées */
+    const LevelFile *level;
+
+    /* chunks du niveau, en colonnes et en lignes */
+    int columns, rows;
+
+    /* pour chaque chunk : sa place (-1 s'il n'est pas chargé), s'il est demandé au thread,
+       et la place lue sans verrou par le thread principal quand il l'a vue prête */
+    int *slot;
+    unsigned char *requested;
+    TileChunk **resident;
+
+    TileChunk *slots;
+    unsigned int frame;
+
+    /* file des chunks demandés au thread */
+    int queue[CHUNK_QUEUE];
+    int queueFirst, queueNumber;
+
+    /* 1 pendant que le thread lit un chunk */
+    int busy;
+    int quit;
+
+    SDL_Thread *thread;
+    SDL_mutex *mutex;
+    SDL_cond *condition;
+
+}ChunkStream;
+
+
+ChunkStream* createChunkStream(struct Map* map);
+int startChunkStream(ChunkStream* stream, const LevelFile* level);
+void stopChunkStream(ChunkStream* stream);
+void streamChunks(Map* map);
+int getTile(Map* map, int x, int y);
+int getSolidity(Map* map, int x, int y);
+int getTileSpans(Map* map, int y, int x1, int x2, TileSpan* spans, int size);
+void destroyChunkStream(ChunkStream* stream);
+
+
+#endif // CHUNK_H_INCLUDED
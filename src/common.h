@@ -16,7 +16,6 @@
 #include <SDL_image.h>
 #include <SDL_ttf.h>
 #include <SDL_mixer.h>
-#include "xml/xml.h"
 #include "log.h"
 
 
@@ -26,6 +25,12 @@
 
 #define TILE_SIZE 70
 
+/* Taille maximale du cache des images (octets), les images utilisées n'en sont jamais retirées */
+#define IMAGE_CACHE_BUDGET (32 * 1024 * 1024)
+
+/* Taille d'un bloc de la mémoire des données d'un niveau (octets) : le plus grand niveau du jeu en utilise 28 Ko */
+#define LEVEL_ARENA_SIZE (128 * 1024)
+
 /* Taille du sprite de notre héros (largeur = width et hauteur = heigth) */
 #define PLAYER_WIDTH 72
 #define PLAYER_HEIGTH 97
@@ -36,6 +41,11 @@
 
 #define PLAYER_SPEED 10
 
+/* Taille et vitesse des monstres */
+#define MONSTER_WIDTH 75
+#define MONSTER_HEIGHT 76
+#define MONSTER_SPEED 3
+
 //Valeurs attribuées aux états/directions
 #define WALK_RIGHT 1
 #define WALK_LEFT 2
@@ -63,6 +73,9 @@
 #define ELEVATOR_SWITCH 13
 #define FLY 300
 
+// nombre de batches d'objets immobiles : types 1 à ELEVATOR_SWITCH, et 0 pour les types inconnus
+#define OBJECT_TYPES (ELEVATOR_SWITCH + 1)
+
 
 // définissant le seuil entre les tiles traversables (blank) et les tiles solides
 #define BLANK_TILE 77
@@ -74,5 +87,8 @@
 
 #define LEVEL_MAX 8
 
+// nombre de frames simulées par défaut en mode headless
+#define HEADLESS_FRAMES 3600
+
 
 #endif
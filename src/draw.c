@@ -3,7 +3,7 @@
  * \brief contains all the drawing functions
  *
  * Implementation of every functions used to display images are implemented here :
- * drawTile, drawImage, drawHud, drawString, draw, loadImage, delay.
+ * drawTile, drawImage, drawHud, drawString, draw, loadImage, copyOpaqueImage, delay.
  *
  * \author François-Xavier Balu, Gwendal Henry, Martin Parisot, Vincent Werner
  */
@@ -13,6 +13,8 @@
 #include "font.h"
 #include "map.h"
 #include "animation.h"
+#include "render.h"
+#include "chunk.h"
 
 /**
  * \fn void drawTile(SDL_Surface *image, int destx,int desty,int srcx, int srcy, Game* game)
@@ -41,7 +43,7 @@ void drawTile(SDL_Surface *image, int destx,int desty,int srcx, int srcy, Game*
    src.w = TILE_SIZE;
    src.h = TILE_SIZE;
 
-   SDL_BlitSurface(image,&src,game->screen,&dest);
+   drawSurface(image,&src,&dest,game);
 }
 
 /**
@@ -53,7 +55,7 @@ void drawTile(SDL_Surface *image, int destx,int desty,int srcx, int srcy, Game*
  * \param[in] y: y-axis coordinate of the image on the screen
  * \param[in] game: contains the necessary informations for the displaying (screen pointers)
  *
- * This functions simplifies the use of SDL_BlitSurface by automatically giving it the needed parameters
+ * This functions simplifies the use of drawSurface by automatically giving it the needed parameters
  *
  */
 void drawImage(SDL_Surface* image,int x,int y, Game* game) {
@@ -65,7 +67,7 @@ void drawImage(SDL_Surface* image,int x,int y, Game* game) {
    dest.w = image->w;
    dest.h = image->h;
 
-   SDL_BlitSurface(image,NULL,game->screen,&dest);
+   drawSurface(image,NULL,&dest,game);
 }
 
 /**
@@ -83,6 +85,7 @@ void drawHud(Game* game)
 {
 
     char text[200];
+    SDL_Color white = {255, 255, 255};
 
     //drawImage(game->HUD_life,50,30, game);
    // sprintf(text, "%d",game->life);
@@ -90,18 +93,35 @@ void drawHud(Game* game)
 
 
    drawImage(game->HUD_life,50,30, game);
-   sprintf(text, "%d",game->life);
-   drawString(text,135,19, 255, 255, 255,game->fontHUD, game);
+   drawImage(game->HUD_coin,810,30, game);
 
+   /* no font in headless mode */
+   if(game->fontHUD == NULL || game->textCache == NULL) {
+      return;
+   }
 
-   drawImage(game->HUD_coin,810,30, game);
-   sprintf(text, "%.4d",game->coin);
-   drawString(text,900,19, 255, 255, 255, game->fontHUD, game);
+   /* Les nombres ne sont recomposés que quand ils changent */
+   if(game->HUD_lifeText == NULL || game->HUD_lifeValue != game->life) {
+      freeImage(game->HUD_lifeText);
+      sprintf(text, "%d",game->life);
+      game->HUD_lifeText = renderNumber(game->textCache, game->fontHUD, text, white);
+      game->HUD_lifeValue = game->life;
+   }
+
+   if(game->HUD_coinText == NULL || game->HUD_coinValue != game->coin) {
+      freeImage(game->HUD_coinText);
+      sprintf(text, "%.4d",game->coin);
+      game->HUD_coinText = renderNumber(game->textCache, game->fontHUD, text, white);
+      game->HUD_coinValue = game->coin;
+   }
+
+   if(game->HUD_lifeText != NULL) drawImage(game->HUD_lifeText,135,19, game);
+   if(game->HUD_coinText != NULL) drawImage(game->HUD_coinText,900,19, game);
 }
 
 /**
  * \fn drawString(char* text, int x, int y, int r,int b, int g, TTF_Font* font,Game* game)
- * \brief
+ * \brief displays a text, rendered once by the text cache of the game
  *
  * \param[in] text:
  * \param[in] x:
@@ -119,15 +139,18 @@ void drawString(char* text, int x, int y, int r,int b, int g, TTF_Font* font,Gam
    SDL_Surface * surface;
    SDL_Color foregroundColor;
 
+   /* no font in headless mode */
+   if(font == NULL || game->textCache == NULL) {
+      return;
+   }
+
    foregroundColor.r = r;
    foregroundColor.b = b;
    foregroundColor.g = g;
 
-   surface = TTF_RenderUTF8_Blended(font,text,foregroundColor);
+   surface = getText(game->textCache, font, text, foregroundColor);
 
    if(surface == NULL) {
-      printf("Couldn't create String %s: %s\n", text, SDL_GetError());
-
       return;
    }
 
@@ -136,9 +159,7 @@ void drawString(char* text, int x, int y, int r,int b, int g, TTF_Font* font,Gam
    dest.w = surface->w;
    dest.h = surface->h;
 
-   SDL_BlitSurface(surface, NULL, game->screen,&dest);
-
-   SDL_FreeSurface(surface);
+   drawSurface(surface, NULL, &dest, game);
 }
 
 /**
@@ -150,21 +171,37 @@ void drawString(char* text, int x, int y, int r,int b, int g, TTF_Font* font,Gam
  */
 void draw(Game* game) {
 
-   drawImage(game->map->background, 0, 0,game);
+   /* the menu will have to be shown again */
+   game->menuOnScreen = 0;
+
+   /* the draws are recorded, then sorted and executed by endFrame() */
+   beginFrame();
+
+   /* les chunks de tiles autour de la caméra sont demandés, les plus loin rendus */
+   streamChunks(game->map);
+
+   setRenderLayer(RENDER_BACKGROUND);
+   drawBackground(game->map, game);
+   markProfile(game->profile, PROFILE_DRAW_BACKGROUND);
 
+   setRenderLayer(RENDER_MAP);
    drawMap(game->map, game);
+   markProfile(game->profile, PROFILE_DRAW_MAP);
 
+   setRenderLayer(RENDER_OBJECT);
    drawObject(game);
+   markProfile(game->profile, PROFILE_DRAW_OBJECT);
 
+   setRenderLayer(RENDER_PLAYER);
    drawAnimatedEntity(game->player, game);
+   markProfile(game->profile, PROFILE_DRAW_PLAYER);
 
+   setRenderLayer(RENDER_HUD);
    drawHud(game);
+   markProfile(game->profile, PROFILE_DRAW_HUD);
 
-   SDL_Flip(game->screen);
-
-   /* Delai */
-
-   SDL_Delay(1); // wtf ????
+   endFrame(game);
+   markProfile(game->profile, PROFILE_DRAW_FLIP);
 
 }
 
@@ -177,13 +214,24 @@ void draw(Game* game) {
  * This function load into memory a picture and convert it to the right color format
  * (set when initializing the SDL_image screen).
  * With this conversion, the display of the picture will be much faster.
+ * A picture without transparency (no alpha channel and no color key) gets no alpha channel:
+ * it is copied on the screen instead of being blended.
+ *
+ * The picture is shared with every other caller loading the same file and must not be
+ * modified. It is given back with releaseImage(), not SDL_FreeSurface().
  *
  * If the loading fails, the function returns NULL.
  */
 SDL_Surface* loadImage(char *name) {
 
-   SDL_Surface* temp = IMG_Load(name);
+   SDL_Surface* temp;
    SDL_Surface* image;
+   int opaque;
+
+   /* déjà décodée ? */
+   if((image = findCachedImage(name)) != NULL) return image;
+
+   temp = IMG_Load(name);
 
    if(temp==NULL) {
       printf("Failed to load image %s\n", name);
@@ -191,9 +239,14 @@ SDL_Surface* loadImage(char *name) {
       return NULL;
    }
 
-   SDL_SetColorKey(temp, SDL_RLEACCEL, temp->format->colorkey);
+   opaque = temp->format->Amask == 0 && (temp->flags & SDL_SRCCOLORKEY) == 0;
 
-   image = SDL_DisplayFormatAlpha(temp);
+   if(opaque) {
+      image = copyOpaqueImage(temp);
+   } else {
+      /* pas de RLE : alphaBlit() lit directement les pixels de l'image */
+      image = SDL_DisplayFormatAlpha(temp);
+   }
 
    SDL_FreeSurface(temp);
 
@@ -203,9 +256,32 @@ SDL_Surface* loadImage(char *name) {
       return NULL;
    }
 
+   addCachedImage(name, image);
+
    return image;
 }
 
+/**
+ * \fn SDL_Surface* copyOpaqueImage(SDL_Surface* image)
+ * \brief copies a picture in the format of the screen, without alpha channel
+ *
+ * \param[in] image: the picture, it is not modified.
+ *
+ * The copy is drawn without blending: every pixel replaces the one of the screen.
+ * It isn't shared by the image cache and is freed with freeImage().
+ * Returns NULL if the conversion fails.
+ */
+SDL_Surface* copyOpaqueImage(SDL_Surface* image) {
+
+   SDL_Surface* copy;
+
+   copy = SDL_DisplayFormat(image);
+
+   if(copy != NULL) SDL_SetAlpha(copy, 0, SDL_ALPHA_OPAQUE);
+
+   return copy;
+}
+
 /**
  * \fn void delay(unsigned int frameLimit)
  * \brief set the framerate at 60 frames per second.
@@ -2,7 +2,7 @@
  * \file game.c
  * \brief contains the necessary functions to create a new game, initialize it, load it or to close it
  *
- * Implementation of createGame, loadGame, initGame and destroyGame.
+ * Implementation of createGame, loadGame, restartLevel, initGame, updateGame and destroyGame.
  *
  * \author François-Xavier Balu, Gwendal Henry, Martin Parisot, Vincent Werner
  *
@@ -16,6 +16,10 @@
 #include "player.h"
 #include "sound.h"
 #include "menu.h"
+#include "object.h"
+#include "render.h"
+#include "scrollcache.h"
+#include "snapshot.h"
 
 
 /**
@@ -41,11 +45,21 @@ Game* createGame() {
       game->endLevel = NULL;
       game->HUD_coin = NULL;
       game->HUD_life = NULL;
+      game->HUD_lifeText = NULL;
+      game->HUD_coinText = NULL;
+      game->HUD_lifeValue = 0;
+      game->HUD_coinValue = 0;
+      game->menuLayer = NULL;
+      game->menuLayerType = -1;
+      game->menuLayerChoice = -1;
+      game->menuOnScreen = 0;
+
 
       game->coin = 0;
       game->life = 0;
 
       game->music = NULL;
+      game->levelMusic = NULL;
       game->miniondead_sound = NULL;
       game->jump_sound = NULL;
       game->coin_sound = NULL;
@@ -58,6 +72,7 @@ Game* createGame() {
       game->menuType = 0;
       game->level = 0;
       game->go = 1;
+      game->headless = 0;
 
 
       game->map = NULL;
@@ -66,6 +81,9 @@ Game* createGame() {
       game->fontHUD = NULL;
       game->fontMenu = NULL;
       game->fontGameover = NULL;
+      game->profile = NULL;
+      game->atlas = NULL;
+      game->textCache = NULL;
 
    }
 
@@ -84,59 +102,55 @@ Game* createGame() {
  */
 void initGame(char* title, Game* game) {
 
+   if(game->headless) {
+      /* no display: SDL's dummy driver gives us an offscreen screen surface */
+      SDL_putenv("SDL_VIDEODRIVER=dummy");
+   }
+
    if(SDL_Init(SDL_INIT_VIDEO)<0) {        /*initialise SDL video*/
       printf("Could not initialize SDL: %s\n", SDL_GetError());
       exit(1);
    }
 
-   /* On crée la fenêtre, représentée par le pointeur jeu.screen en utilisant la largeur et la
-   hauteur définies dans les defines (defs.h). On utilise aussi la mémoire vidéo
-   (SDL_HWPALETTE) et le double buffer pour éviter que ça scintille
-   (SDL_DOUBLEBUF) */
+   /* crée la fenêtre, ou un écran hors de l'affichage en mode headless */
+   openScreen(title, game);
 
-   game->screen = SDL_SetVideoMode(SCREEN_WIDTH,SCREEN_HEIGHT,0,SDL_HWPALETTE|SDL_DOUBLEBUF);
+   /* the headless mode has no window, no font and no sound card */
+   if(game->headless == 0) {
 
+      if(TTF_Init()<0) {
+         printf("couldn't initialize  SDL_TTF: %s\n",SDL_GetError());
+         exit(1);
+      }
+      game->fontHUD = loadFont("data/font/font1.ttf", 65);
+      game->fontMenu = loadFont("data/font/font1.ttf", 45);
+      game->fontGameover = loadFont("data/font/font1.ttf",65);
+      game->textCache = createTextCache();
 
-   if(game->screen == NULL) {
-      printf("Couldn't set screen mode to %d x %d: %s\n", SCREEN_WIDTH, SCREEN_HEIGHT, SDL_GetError());
-      exit(1);
-   }
 
-   SDL_WM_SetCaption(title,NULL); /*on affiche le titre de la fenetre*/
+      int flags = MIX_INIT_FLAC; // Le mp3 ne marchait pas
+      int initted = Mix_Init(flags);
 
-   SDL_ShowCursor(SDL_DISABLE);
+      printf("%d\n",flags);
+      printf("%d\n",initted);
 
-   if(TTF_Init()<0) {
-      printf("couldn't initialize  SDL_TTF: %s\n",SDL_GetError());
-      exit(1);
-   }
-   game->fontHUD = loadFont("data/font/font1.ttf", 65);
-   game->fontMenu = loadFont("data/font/font1.ttf", 45);
-   game->fontGameover = loadFont("data/font/font1.ttf",65);
+      if( (initted & flags) != flags) {
+         printf("Mix_Init: Failed to init SDL_Mixer\n");
+         printf("Mix_Init: %s\n", Mix_GetError());
+         exit(1);
+      }
 
+      /* open 44.1KHz, signed 16bit, system byte order,
+             stereo audio, using 1024 byte chunks */
+      if(Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, 1024)==-1) {
+         printf("Mix_OpenAudio: %s\n", Mix_GetError());
+         exit(1);
+      }
 
-   int flags = MIX_INIT_FLAC; // Le mp3 ne marchait pas
-   int initted = Mix_Init(flags);
-
-   printf("%d\n",flags);
-   printf("%d\n",initted);
-
-   if( (initted & flags) != flags) {
-      printf("Mix_Init: Failed to init SDL_Mixer\n");
-      printf("Mix_Init: %s\n", Mix_GetError());
-      exit(1);
-   }
-
-   /* open 44.1KHz, signed 16bit, system byte order,
-          stereo audio, using 1024 byte chunks */
-   if(Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, 1024)==-1) {
-      printf("Mix_OpenAudio: %s\n", Mix_GetError());
-      exit(1);
+      /* Définit le nombre de channels à mixer */
+      Mix_AllocateChannels(32);
    }
 
-   /* Définit le nombre de channels à mixer */
-   Mix_AllocateChannels(32);
-
    game->level = 0;
    game->onMenu = 1;
    game->choice = 0;
@@ -157,30 +171,116 @@ void initGame(char* title, Game* game) {
 void loadGame(Game* game) {
 
    char file[200];
+   double start = getTime(), startMap;
 
    if(game->map->background == NULL )   game->map->background = loadImage("data/graphics/backgroundworld1.png");
    if(game->map->backgroundMenu == NULL)   game->map->backgroundMenu = loadImage("data/graphics/splashScreen.png");
    if(game->tileMenu == NULL)   game->tileMenu = loadImage("data/graphics/spriteSheetMenu.png");
    if(game->tileSelectLevel== NULL)   game->tileSelectLevel = loadImage("data/graphics/tileSelectLevel.png");
    if(game->map->tileSet== NULL)   game->map->tileSet = loadImage("data/graphics/all_tileset.png");
+   if(game->map->tileOpacity == NULL)   classifyTiles(game->map);
+   if(game->map->scrollCache == NULL)   game->map->scrollCache = createScrollCache(game->map->tileSet);
    if(game->gameover== NULL )  game->gameover = loadImage("data/graphics/gameover.png");
    if(game->endLevel== NULL )  game->endLevel = loadImage("data/graphics/splashScreenEndLevel.png");
    if(game->HUD_life == NULL)  game->HUD_life = loadImage("data/graphics/lifeHud.png");
    if(game->HUD_coin== NULL)   game->HUD_coin = loadImage("data/graphics/hud_coins.png");
+   if(game->atlas == NULL)   game->atlas = createAtlas();
 
-   loadSong(-1,"data/music/Those of Us Who Fight.mp3",game);
+   playLevelSong(game);
 
    loadSound(game);
 
 
    /* Charge la map depuis le fichier */
    sprintf(file, "data/map/map%d.tmx", game->level );
+   startMap = getTime();
    loadMap(file, game->map, game);
 
     game->doGameover =1;
     game->coin = 0;
     game->life = 1;
 
+   if(game->profile != NULL) {
+      game->profile->loadMap = getTime() - startMap;
+      game->profile->loadGame = getTime() - start;
+   }
+
+}
+
+/**
+ * \fn void restartLevel(Game* game)
+ * \brief Start the current level again, after a game over
+ *
+ * \param[in] game: pointer to the Game structure.
+ *
+ * The level is put back in the state copied when it was loaded (snapshot.h): the TMX file isn't read
+ * and nothing is allocated. If the map contains another level, or the copy couldn't be made, loadGame() loads it.
+ */
+void restartLevel(Game* game) {
+
+   double start = getTime();
+
+   if(game->map->snapshot == NULL || game->map->snapshot->level != game->level) {
+      loadGame(game);
+      return;
+   }
+
+   playLevelSong(game);
+
+   restoreLevelSnapshot(game->map->snapshot, game->map);
+
+   game->doGameover = 1;
+   game->coin = 0;
+   game->life = 1;
+
+   if(game->profile != NULL) {
+      game->profile->loadMap = 0;
+      game->profile->loadGame = getTime() - start;
+   }
+}
+
+/**
+ * \fn void updateGame(Game* game)
+ * \brief Run one frame of the game from the current inputs
+ *
+ * \param[in] game: pointer to the Game structure.
+ *
+ * Updates and draws either the level or the current menu. The inputs must have been read before.
+ */
+void updateGame(Game* game) {
+
+   /* escape goes back to the start menu */
+   if(game->input->pause == 1) {
+      game->menuType = START;
+      game->onMenu = 1;
+      game->input->pause = 0;
+   }
+
+   /* checks if menu is used */
+   if(game->onMenu == 0) {
+      /* updates game */
+      updatePlayer(game->player,game);
+      markProfile(game->profile, PROFILE_PLAYER);
+      updateObject(game);
+      markProfile(game->profile, PROFILE_OBJECT);
+
+      /* displays everything */
+      draw(game);
+
+   } else {
+      switch(game->menuType) {
+
+      case START :
+         updateStartMenu(game->input,game);
+         drawStartMenu(game); // ya un bug ici !
+         break;
+
+      case SELECT_LEVEL :
+         updateSelectLevelMenu(game->input,game);
+         drawSelectLevelMenu(game);
+
+      }
+   }
 }
 
 /**
@@ -195,31 +295,33 @@ void destroyGame(Game* game) {
 
    if(game != NULL) {
 
-      SDL_FreeSurface(game->tileMenu);
-      SDL_FreeSurface(game->tileSelectLevel);
-      SDL_FreeSurface(game->gameover);
-      SDL_FreeSurface(game->HUD_coin);
-      SDL_FreeSurface(game->HUD_life);
-      SDL_FreeSurface(game->endLevel);
-      SDL_FreeSurface(game->screen);
-
+      releaseImage(game->tileMenu);
+      releaseImage(game->tileSelectLevel);
+      releaseImage(game->gameover);
+      releaseImage(game->HUD_coin);
+      releaseImage(game->HUD_life);
+      releaseImage(game->endLevel);
+      freeImage(game->HUD_lifeText);
+      freeImage(game->HUD_coinText);
+      freeImage(game->menuLayer);
+
+      destroyTextCache(game->textCache);
       closeFont(game->fontHUD);
       closeFont(game->fontMenu);
       closeFont(game->fontGameover);
 
-      Mix_FreeMusic(game->music);
+      if(game->music != game->levelMusic) Mix_FreeMusic(game->music);
+      Mix_FreeMusic(game->levelMusic);
       freeSound(game);
-      Mix_CloseAudio();
-
-
-        destroyInput(game->input);
-        destroyPlayer(game->player);
-        destroyMap(game->map);
+      if(game->headless == 0) Mix_CloseAudio();
 
 
       destroyInput(game->input);
       destroyPlayer(game->player);
       destroyMap(game->map);
+      destroyAtlas(game->atlas);
+      clearImageCache();
+      closeScreen(game);
 
 
       free(game);
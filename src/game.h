@@ -2,7 +2,7 @@
  * \file game.h
  * \brief header of game.c
  *
- * Declaration of createGame_(), loadGame(), initGame() and destroyGame().
+ * Declaration of createGame_(), loadGame(), restartLevel(), initGame(), updateGame() and destroyGame().
  * Creation of structures Input, GameObject, Map and Game.
  *
  * \author François-Xavier Balu, Gwendal Henry, Martin Parisot, Vincent Werner
@@ -11,6 +11,9 @@
 #ifndef INIT_H_INCLUDED
 #define INIT_H_INCLUDED
 #include "common.h"
+#include "profile.h"
+#include "atlas.h"
+#include "text.h"
 
 
 typedef struct Input{
@@ -21,8 +24,8 @@ typedef struct Input{
 
 
 typedef struct GameObject{
-   //Sprite de l'objet
-   SDL_Surface *sprite;
+   //Animation de l'objet dans l'atlas
+   int clip;
 
    int type;
    int spe;
@@ -43,23 +46,106 @@ typedef struct GameObject{
    float dirX, dirY;
    int saveX, saveY;
 
+   /* bornes de la patrouille des monstres */
+   int patrolMinX, patrolMaxX;
+
 } GameObject;
 
 
+/* colonnes start à end - 1 d'une ligne de la map, sans tile vide ni transparente */
+typedef struct TileSpan{
+
+    int start, end;
+
+} TileSpan;
+
+
+/* objets immobiles d'un même type, rangés par x croissant avec une table par champ */
+typedef struct ObjectBatch{
+
+    int number;
+
+    /* lus à chaque frame */
+    int *x, *y;
+    int *initialized;
+
+    /* lus pour dessiner l'objet ou quand le joueur le touche */
+    int *gid;
+    int *spe;
+
+    /* groupe de blocs d'un interrupteur ou d'un bloc (Map.groupStart), -1 pour les autres objets */
+    int *group;
+
+    /* place de l'objet dans le TMX */
+    int *index;
+
+} ObjectBatch;
+
+
 typedef struct Map{
 
     SDL_Surface *background;
     SDL_Surface *tileSet;
     SDL_Surface *backgroundMenu;
 
-    XML_File* xmlLevel;
+    /* opacité de chaque tile du tileset (TILE_*), et copie sans alpha des tiles opaques */
+    unsigned char *tileOpacity;
+    int tileNumber;
+    SDL_Surface *tileSetOpaque;
+
+    /* tiles visibles gardées d'une frame à l'autre (scrollcache.h) */
+    struct ScrollCache *scrollCache;
+
+    /* toutes les données du niveau chargé, rendues d'un coup au chargement du suivant (arena.h) */
+    struct Arena *arena;
 
     int startX, startY;
     int maxX, maxY;
     int sizeX,sizeY;
 
-    GameObject *objects;
-    int **tile;
+    /* objets immobiles, une batch par type (batches[0] pour les types inconnus) */
+    ObjectBatch batches[OBJECT_TYPES];
+
+    /* monstres, les seuls objets animés et qui bougent */
+    GameObject *monsters;
+    int monsterNumber;
+
+    /* x des monstres par ordre croissant et leur place dans monsters (index), remis en ordre quand ils bougent ;
+       les autres tables de cette batch ne sont pas allouées */
+    ObjectBatch monsterBatch;
+
+    /* type (FLY pour un monstre) et place dans sa batch de chaque objet du TMX */
+    int *objectType;
+    int *objectSlot;
+
+    /* incrémenté à chaque niveau chargé */
+    int generation;
+
+    /* blocs commandés par les interrupteurs : ceux du groupe g sont dans batches[groupColor[g]],
+       aux places groupBlocks[groupStart[g]] à groupBlocks[groupStart[g + 1] - 1] */
+    int *groupBlocks;
+    int *groupStart;
+    int *groupColor;
+    int groupNumber;
+
+    /* volumes de déclenchement des objets immobiles, rangés par chunk (trigger.h) */
+    struct TriggerTable *triggers;
+
+    /* niveau cuit, projeté en mémoire (levelfile.h), et ses tiles autour de la caméra, copiées par chunks (chunk.h) */
+    struct LevelFile *levelFile;
+    struct ChunkStream *chunks;
+
+    /* niveau suivant, ouvert d'avance par un thread pendant un écran de transition (preload.h) */
+    struct LevelPreload *preload;
+
+    /* tiles sous les blocs (y * sizeX + x), triées, et le nombre de blocs solides posés sur chacune (placeSolidBlocks) ;
+       la solidité des tiles elles-mêmes est lue dans leurs chunks (chunk.h) */
+    int *blockTiles;
+    unsigned char *blockSolid;
+    int blockTileNumber;
+
+    /* état du niveau juste après son chargement (snapshot.h) */
+    struct LevelSnapshot *snapshot;
 
 } Map;
 
@@ -74,10 +160,23 @@ typedef struct Game{
     SDL_Surface* HUD_life;
     SDL_Surface* HUD_coin;
 
+    /* nombres du HUD, recomposés seulement quand leur valeur change */
+    SDL_Surface* HUD_lifeText;
+    SDL_Surface* HUD_coinText;
+    int HUD_lifeValue, HUD_coinValue;
+
+    /* écran du menu déjà composé, pour le menu menuLayerType et le choix menuLayerChoice */
+    SDL_Surface* menuLayer;
+    int menuLayerType, menuLayerChoice;
+    int menuOnScreen;
+
     int coin;
     int life;
 
     Mix_Music* music;
+
+    /* musique des niveaux, chargée une seule fois */
+    Mix_Music* levelMusic;
     Mix_Chunk *miniondead_sound, *jump_sound, *coin_sound, *deadplayer1_sound, *switch_sound;
 
     int doGameover;
@@ -85,6 +184,7 @@ typedef struct Game{
     int onMenu, menuType, choice;
     int level;
     int go;
+    int headless;
 
     Map *map;
     GameObject* player;
@@ -93,11 +193,17 @@ typedef struct Game{
     TTF_Font *fontGameover;
     TTF_Font *fontHUD;
 
+    Profile *profile;
+    Atlas *atlas;
+    TextCache *textCache;
+
 }Game;
 
 
 void initGame(char *title,Game* game);
 void loadGame(Game* game);
+void restartLevel(Game* game);
+void updateGame(Game* game);
 void destroyGame(Game* game);
 Game* createGame();
 
@@ -0,0 +1,197 @@
+/**
+ * \file imagecache.c
+ * \brief contains the cache of the pictures loaded by loadImage()
+ *
+ * Implementation of findCachedImage, addCachedImage, releaseImage, setImageCacheBudget
+ * and clearImageCache.
+ *
+ * Each picture is decoded once and shared by everything using the same file.
+ * An entry counts its users: releaseImage() gives a reference back instead of freeing the surface.
+ * The pictures no longer used stay in the cache, so loading them again costs nothing,
+ * until the cache grows over its budget. Then the least recently used of them are freed.
+ *
+ * \author François-Xavier Balu, Gwendal Henry, Martin Parisot, Vincent Werner
+ */
+
+#include "imagecache.h"
+#include "render.h"
+
+
+typedef struct CachedImage{
+
+    char *name;
+    SDL_Surface *image;
+
+    int references;
+    unsigned long lastUse;
+    long size;
+
+    struct CachedImage *next;
+
+}CachedImage;
+
+
+static CachedImage *cache = NULL;
+
+/* taille totale des surfaces en cache (octets), et taille maximale (0 = pas de limite) */
+static long cacheSize = 0;
+static long cacheBudget = IMAGE_CACHE_BUDGET;
+
+/* horloge des accès pour trouver l'image utilisée le moins récemment */
+static unsigned long useClock = 0;
+
+
+/**
+ * \fn static void evictImages()
+ * \brief frees the unused pictures, least recently used first, until the cache fits in its budget
+ */
+static void evictImages() {
+
+   CachedImage **entry, **oldest, *victim;
+
+   while(cacheBudget > 0 && cacheSize > cacheBudget) {
+      oldest = NULL;
+
+      for(entry = &cache; *entry != NULL; entry = &((*entry)->next)) {
+         if((*entry)->references == 0 && (oldest == NULL || (*entry)->lastUse < (*oldest)->lastUse)) {
+            oldest = entry;
+         }
+      }
+
+      /* toutes les images restantes sont utilisées */
+      if(oldest == NULL) return;
+
+      victim = *oldest;
+      *oldest = victim->next;
+
+      cacheSize -= victim->size;
+      freeImage(victim->image);
+      free(victim->name);
+      free(victim);
+   }
+}
+
+/**
+ * \fn SDL_Surface* findCachedImage(char* name)
+ * \brief looks for a picture already loaded
+ *
+ * \param[in] name: name of the picture file.
+ *
+ * If the picture is in the cache, the caller gets a new reference on it,
+ * to give back with releaseImage(). Otherwise the function returns NULL.
+ */
+SDL_Surface* findCachedImage(char* name) {
+
+   CachedImage *entry;
+
+   for(entry = cache; entry != NULL; entry = entry->next) {
+      if(strcmp(entry->name, name) == 0) {
+         entry->references++;
+         entry->lastUse = ++useClock;
+
+         return entry->image;
+      }
+   }
+
+   return NULL;
+}
+
+/**
+ * \fn void addCachedImage(char* name, SDL_Surface* image)
+ * \brief adds a picture just loaded to the cache
+ *
+ * \param[in] name: name of the picture file.
+ * \param[in] image: the loaded picture, the caller holds the first reference on it.
+ *
+ * If the entry can't be allocated, the picture is simply not cached and
+ * releaseImage() will free it.
+ */
+void addCachedImage(char* name, SDL_Surface* image) {
+
+   CachedImage *entry;
+
+   if((entry = (CachedImage*)malloc(sizeof(CachedImage))) == NULL
+      || (entry->name = (char*)malloc(strlen(name) + 1)) == NULL) {
+      fprintf(stderr, "can't allocate memory for the cache of %s\n", name);
+      free(entry);
+
+      return;
+   }
+
+   strcpy(entry->name, name);
+   entry->image = image;
+   entry->references = 1;
+   entry->lastUse = ++useClock;
+   entry->size = (long)image->pitch * image->h;
+
+   entry->next = cache;
+   cache = entry;
+
+   cacheSize += entry->size;
+   evictImages();
+}
+
+/**
+ * \fn void releaseImage(SDL_Surface* image)
+ * \brief gives back a picture obtained with loadImage()
+ *
+ * \param[in] image: the picture, may be NULL.
+ *
+ * The picture stays in the cache when nobody uses it anymore, it is only freed
+ * when the cache is over its budget. A picture unknown to the cache is freed.
+ */
+void releaseImage(SDL_Surface* image) {
+
+   CachedImage *entry;
+
+   if(image == NULL) return;
+
+   for(entry = cache; entry != NULL; entry = entry->next) {
+      if(entry->image == image) {
+         if(entry->references > 0) entry->references--;
+
+         evictImages();
+
+         return;
+      }
+   }
+
+   freeImage(image);
+}
+
+/**
+ * \fn void setImageCacheBudget(long budget)
+ * \brief changes the maximum size of the cache
+ *
+ * \param[in] budget: size in bytes, 0 to keep every picture.
+ *
+ * The pictures still used are never freed, even if they don't fit in the budget.
+ */
+void setImageCacheBudget(long budget) {
+
+   cacheBudget = budget;
+
+   evictImages();
+}
+
+/**
+ * \fn void clearImageCache()
+ * \brief frees every picture of the cache
+ *
+ * To call when closing the game, after the last releaseImage().
+ */
+void clearImageCache() {
+
+   CachedImage *entry;
+
+   while(cache != NULL) {
+      entry = cache;
+      cache = entry->next;
+
+      freeImage(entry->image);
+      free(entry->name);
+      free(entry);
+   }
+
+   cacheSize = 0;
+}
@@ -0,0 +1,24 @@
+/**
+ * \file imagecache.h
+ * \brief header of imagecache.c
+ *
+ * Declaration of findCachedImage(), addCachedImage(), releaseImage(), setImageCacheBudget()
+ * and clearImageCache().
+ *
+ * \author François-Xavier Balu, Gwendal Henry, Martin Parisot, Vincent Werner
+ */
+
+#ifndef IMAGECACHE_H_INCLUDED
+#define IMAGECACHE_H_INCLUDED
+
+#include "common.h"
+
+
+SDL_Surface* findCachedImage(char* name);
+void addCachedImage(char* name, SDL_Surface* image);
+void releaseImage(SDL_Surface* image);
+void setImageCacheBudget(long budget);
+void clearImageCache();
+
+
+#endif // IMAGECACHE_H_INCLUDED
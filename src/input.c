@@ -2,7 +2,7 @@
  * \file input.c
  * \brief  Functions to manage the user's inputs
  *
- *	Implementation of CreateInput, getInput and destroyInput.
+ *	Implementation of CreateInput, getInput, waitInput and destroyInput.
  *
  * \author François-Xavier Balu, Gwendal Henry, Martin Parisot, Vincent Werner
  */
@@ -63,9 +63,7 @@ void getInput(Input* input,Game* game) {
       case SDL_KEYDOWN:
          switch (event.key.keysym.sym) {
          case SDLK_ESCAPE:
-
-            game->menuType = START;
-            game->onMenu =1;
+            input->pause = 1;
             break;
 
          case SDLK_SPACE:
@@ -140,6 +138,18 @@ void getInput(Input* input,Game* game) {
    }
 }
 
+/**
+ * \fn void waitInput()
+ * \brief Wait until the user does something
+ *
+ * The event is left in the queue for getInput().
+ * Used while nothing moves on the screen, so the game doesn't use the CPU for nothing.
+ */
+void waitInput() {
+
+   SDL_WaitEvent(NULL);
+}
+
 
 /**
  * \fn destroyInput(Input* input)
@@ -2,7 +2,7 @@
  * \file input.h
  * \brief header of input.c
  *
- * Declaration of createInput, getInput and destroyInput.
+ * Declaration of createInput, getInput, waitInput and destroyInput.
  *
  * \author François-Xavier Balu, Gwendal Henry, Martin Parisot, Vincent Werner
  *
@@ -14,6 +14,7 @@
 #include "game.h"
 
 void getInput(Input* input,Game* game);
+void waitInput();
 Input* createInput();
 void destroyInput(Input* input);
 
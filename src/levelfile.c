@@ -0,0 +1,514 @@
+/**
+ * \file levelfile.c
+ * \brief contains the cooked levels: the TMX files converted once in a binary file used in place
+ *
+ * Implementation of cookLevel, openLevelFile and closeLevelFile.
+ *
+ * A cooked level (data/map/mapN.lvl next to data/map/mapN.tmx) is a LevelHeader followed by the tiles stored by chunk,
+ * the solidity of the tiles stored by chunk as well, and the objects. openLevelFile() maps it in memory: loading a level
+ * reads no text, and the tiles of a chunk and their solidity are copied from the file when the chunk is needed (chunk.h).
+ * The level is cooked again when its version isn't LEVEL_FILE_VERSION or when the content of the TMX changed.
+ * If it can't be written next to the TMX, it is cooked in a temporary file.
+ *
+ * \author François-Xavier Balu, Gwendal Henry, Martin Parisot, Vincent Werner
+ */
+
+#include "levelfile.h"
+#include "chunk.h"
+#include "tmx.h"
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <errno.h>
+#else
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+/* un niveau cuit par rapport à son TMX (getSourceState) */
+#define SOURCE_CHANGED 0
+#define SOURCE_SAME 1
+#define SOURCE_TOUCHED 2
+
+
+/**
+ * \fn static void getLevelName(const char* name, char* levelName, int size)
+ * \brief Give the name of the cooked level of a TMX file: its extension replaced by .lvl
+ */
+static void getLevelName(const char* name, char* levelName, int size) {
+
+   const char *dot = strrchr(name, '.'), *slash = strrchr(name, '/');
+   int length = (dot != NULL && (slash == NULL || dot > slash)) ? (int)(dot - name) : (int)strlen(name);
+
+   if(length > size - 5) length = size - 5;
+
+   memcpy(levelName, name, length);
+   strcpy(levelName + length, ".lvl");
+}
+
+/**
+ * \fn static int hashFile(const char* name, Uint32* hash)
+ * \brief Compute the FNV-1a hash of the content of a file, 0 if it can't be read
+ */
+static int hashFile(const char* name, Uint32* hash) {
+
+   unsigned char buffer[4096];
+   size_t i, number;
+   FILE* file;
+
+   if((file = fopen(name, "rb")) == NULL) return 0;
+
+   *hash = 2166136261u;
+
+   while((number = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+      for(i = 0; i < number; i++) *hash = (*hash ^ buffer[i]) * 16777619u;
+   }
+
+   fclose(file);
+
+   return 1;
+}
+
+/**
+ * \fn static int getSourceInfo(const char* name, Uint32* size, Uint64* time)
+ * \brief Give the size and the date of a file, 0 if it doesn't exist
+ */
+static int getSourceInfo(const char* name, Uint32* size, Uint64* time) {
+
+   struct stat info;
+
+   if(stat(name, &info) != 0) return 0;
+
+   *size = (Uint32)info.st_size;
+   *time = (Uint64)info.st_mtime;
+
+   return 1;
+}
+
+/**
+ * \fn static int writeBand(FILE* out, const LevelHeader* header, Sint32* band, unsigned char* solid, int row)
+ * \brief Write the tiles and the solidity of the chunks of a row of chunks, then clear them
+ *
+ * \param[in, out] out: the cooked level
+ * \param[in] header: the size and the positions of the parts of the level
+ * \param[in, out] band: the tiles of the chunks of the row, chunk after chunk
+ * \param[in, out] solid: the solidity of the same tiles, in the same order
+ * \param[in] row: the row of chunks
+ * \return 0 if the file couldn't be written
+ */
+static int writeBand(FILE* out, const LevelHeader* header, Sint32* band, unsigned char* solid, int row) {
+
+   int columns = (header->sizeX + CHUNK_SIZE - 1) / CHUNK_SIZE;
+   size_t tiles = (size_t)columns * CHUNK_SIZE * CHUNK_SIZE;
+
+   if(fseek(out, header->tileOffset + (long)(row * tiles * sizeof(Sint32)), SEEK_SET) != 0 ||
+      fwrite(band, sizeof(Sint32), tiles, out) != tiles) return 0;
+
+   if(fseek(out, header->solidOffset + (long)(row * tiles), SEEK_SET) != 0 ||
+      fwrite(solid, 1, tiles, out) != tiles) return 0;
+
+   memset(band, 0, tiles * sizeof(Sint32));
+   memset(solid, 0, tiles);
+
+   return 1;
+}
+
+/**
+ * \fn static int isBlock(int type)
+ * \brief Tell if an object is a block, which makes the tile it covers solid (placeSolidBlocks())
+ */
+static int isBlock(int type) {
+
+   return type == BLUE_BLOCK || type == GREEN_BLOCK || type == YELLOW_BLOCK || type == RED_BLOCK || type == ELEVATOR_BLOCK;
+}
+
+/**
+ * \fn static int writeLevel(const char* name, FILE* out)
+ * \brief Cook a TMX file
+ *
+ * \param[in] name: the TMX file
+ * \param[in, out] out: the cooked level, opened for writing
+ * \return 0 if the TMX couldn't be read, has a block outside the tile grid, or the cooked level couldn't be written
+ *
+ * The TMX is read once. The tiles are kept one row of chunks at a time, so cooking a large level
+ * doesn't need memory for all its tiles. Only the first layer of tiles and the last layer of objects are read.
+ */
+static int writeLevel(const char* name, FILE* out) {
+
+   LevelHeader header;
+   LevelRecord *objects = NULL, *larger;
+   TmxReader reader;
+   TmxTag tag;
+   Sint32* band = NULL;
+   unsigned char* solid = NULL;
+   int i, x, y, columns = 0, rows = 0, row = 0, tiles = 0, layer = 0, objectLayer = 0, objectSize = 0, written = 1;
+
+   memset(&header, 0, sizeof(LevelHeader));
+   memcpy(header.magic, "LVL", 4);
+   header.version = LEVEL_FILE_VERSION;
+   header.tileOffset = header.solidOffset = header.objectOffset = sizeof(LevelHeader);
+
+   if(getSourceInfo(name, &header.sourceSize, &header.sourceTime) == 0 || hashFile(name, &header.hash) == 0 ||
+      openTmxReader(&reader, name) == 0) return 0;
+
+   while(written && readTmxTag(&reader, &tag)) {
+
+      if(tag.closing) {
+         /* seule la première couche de tiles est lue */
+         if(strcmp(tag.name, "layer") == 0 && layer == 1) layer = 2;
+         if(strcmp(tag.name, "objectgroup") == 0) objectLayer = 0;
+
+         continue;
+      }
+
+      if(strcmp(tag.name, "map") == 0 && band == NULL) {
+
+         header.sizeX = getTmxInt(&tag, "width");
+         header.sizeY = getTmxInt(&tag, "height");
+
+         if(header.sizeX < 0 || header.sizeY < 0) header.sizeX = header.sizeY = 0;
+
+         columns = (header.sizeX + CHUNK_SIZE - 1) / CHUNK_SIZE;
+         rows = (header.sizeY + CHUNK_SIZE - 1) / CHUNK_SIZE;
+
+         header.solidOffset = header.tileOffset + columns * rows * CHUNK_SIZE * CHUNK_SIZE * sizeof(Sint32);
+         header.objectOffset = (header.solidOffset + columns * rows * CHUNK_SIZE * CHUNK_SIZE + 3) & ~3u;
+
+         band = (Sint32*)calloc((size_t)columns * CHUNK_SIZE * CHUNK_SIZE + 1, sizeof(Sint32));
+         solid = (unsigned char*)calloc((size_t)columns * CHUNK_SIZE * CHUNK_SIZE + 1, 1);
+
+         if(band == NULL || solid == NULL) {
+            fprintf(stderr, "can't allocate memory to cook %s\n", name);
+            written = 0;
+         }
+      }
+
+      else if(strcmp(tag.name, "layer") == 0 && layer == 0) layer = 1;
+
+      /* les tiles, ligne par ligne : une ligne de chunks est écrite quand la suivante commence */
+      else if(strcmp(tag.name, "tile") == 0 && layer == 1 && tiles < header.sizeX * header.sizeY) {
+
+         x = tiles % header.sizeX;
+         y = tiles / header.sizeX;
+
+         while(written && y / CHUNK_SIZE > row) written = writeBand(out, &header, band, solid, row++);
+
+         i = (x / CHUNK_SIZE) * CHUNK_SIZE * CHUNK_SIZE + (y % CHUNK_SIZE) * CHUNK_SIZE + x % CHUNK_SIZE;
+
+         band[i] = getTmxInt(&tag, "gid");
+         solid[i] = band[i] > BLANK_TILE;
+
+         tiles++;
+      }
+
+      /* la dernière couche d'objets */
+      else if(strcmp(tag.name, "objectgroup") == 0) {
+         objectLayer = 1;
+         header.objectNumber = 0;
+      }
+
+      else if(strcmp(tag.name, "object") == 0 && objectLayer) {
+
+         if(header.objectNumber == objectSize) {
+            objectSize = objectSize > 0 ? 2 * objectSize : 64;
+
+            if((larger = (LevelRecord*)realloc(objects, objectSize * sizeof(LevelRecord))) == NULL) {
+               fprintf(stderr, "can't allocate memory to cook %s\n", name);
+               written = 0;
+               continue;
+            }
+
+            objects = larger;
+         }
+
+         objects[header.objectNumber].type = getTmxInt(&tag, "name");
+         objects[header.objectNumber].spe = getTmxInt(&tag, "type");
+         objects[header.objectNumber].gid = getTmxInt(&tag, "gid");
+         objects[header.objectNumber].x = getTmxInt(&tag, "x");
+         objects[header.objectNumber].y = getTmxInt(&tag, "y");
+         objects[header.objectNumber].group = 0;
+
+         /* un bloc remplace une tile dans la solidité : posé à côté de la grille, il ne correspondrait pas à ce qui est dessiné */
+         if(isBlock(objects[header.objectNumber].type) &&
+            (objects[header.objectNumber].x % TILE_SIZE != 0 || objects[header.objectNumber].y % TILE_SIZE != 0)) {
+            fprintf(stderr, "%s: the block at (%d, %d) isn't on the grid of tiles of %d pixels\n", name,
+                    (int)objects[header.objectNumber].x, (int)objects[header.objectNumber].y, TILE_SIZE);
+            written = 0;
+         }
+
+         header.objectNumber++;
+      }
+
+      /* <properties><property name="group" value="1"/></properties> dans l'objet */
+      else if(strcmp(tag.name, "property") == 0 && objectLayer && header.objectNumber > 0 &&
+              strcmp(getTmxAttribute(&tag, "name"), "group") == 0) {
+         objects[header.objectNumber - 1].group = getTmxInt(&tag, "value");
+      }
+   }
+
+   closeTmxReader(&reader);
+
+   /* les lignes de chunks restantes, et celles qui manquent dans le TMX */
+   while(written && row < rows) written = writeBand(out, &header, band, solid, row++);
+
+   if(written && header.objectNumber > 0) {
+      written = fseek(out, header.objectOffset, SEEK_SET) == 0 &&
+                fwrite(objects, sizeof(LevelRecord), header.objectNumber, out) == (size_t)header.objectNumber;
+   }
+
+   /* l'en-tête en dernier : un fichier interrompu n'a pas de version valide */
+   if(written) written = fseek(out, 0, SEEK_SET) == 0 && fwrite(&header, sizeof(LevelHeader), 1, out) == 1 && fflush(out) == 0;
+
+   free(band);
+   free(solid);
+   free(objects);
+
+   return written;
+}
+
+/**
+ * \fn int cookLevel(const char* name)
+ * \brief Cook a TMX file in the .lvl file of the same name
+ *
+ * \param[in] name: the TMX file
+ * \return 0 if it couldn't be cooked
+ */
+int cookLevel(const char* name) {
+
+   char levelName[256], tempName[264];
+   FILE* out;
+   int written;
+
+   getLevelName(name, levelName, sizeof(levelName));
+
+   /* cuit à côté puis renommé : un .lvl encore projeté (niveau en cours, ou ouvert d'avance par preload.h)
+      n'est jamais réécrit */
+   sprintf(tempName, "%s.tmp", levelName);
+
+   if((out = fopen(tempName, "wb")) == NULL) return 0;
+
+   written = writeLevel(name, out);
+
+   if(fclose(out) != 0) written = 0;
+
+#ifdef _WIN32
+   /* rename ne remplace pas un fichier existant, qui ne peut pas être supprimé tant qu'il est projeté */
+   if(written && remove(levelName) != 0 && errno != ENOENT) written = 0;
+#endif
+
+   if(written && rename(tempName, levelName) != 0) written = 0;
+
+   if(written == 0) remove(tempName);
+
+   return written;
+}
+
+/**
+ * \fn static int checkLevelFile(LevelFile* level)
+ * \brief Check the header of a cooked level and find its parts
+ * \return 0 if the file isn't a cooked level of this version, or is too short
+ */
+static int checkLevelFile(LevelFile* level) {
+
+   const LevelHeader* header = (const LevelHeader*)level->data;
+   Uint64 columns, rows;
+
+   if(level->size < sizeof(LevelHeader) || memcmp(header->magic, "LVL", 4) != 0 || header->version != LEVEL_FILE_VERSION) return 0;
+
+   if(header->sizeX < 0 || header->sizeY < 0 || header->objectNumber < 0 || (header->tileOffset & 3) || (header->objectOffset & 3)) return 0;
+
+   columns = (header->sizeX + CHUNK_SIZE - 1) / CHUNK_SIZE;
+   rows = (header->sizeY + CHUNK_SIZE - 1) / CHUNK_SIZE;
+
+   if(header->tileOffset + columns * rows * CHUNK_SIZE * CHUNK_SIZE * sizeof(Sint32) > header->solidOffset ||
+      header->solidOffset + columns * rows * CHUNK_SIZE * CHUNK_SIZE > header->objectOffset ||
+      header->objectOffset + (Uint64)header->objectNumber * sizeof(LevelRecord) > level->size) return 0;
+
+   level->header = header;
+   level->tiles = (const Sint32*)(level->data + header->tileOffset);
+   level->solid = level->data + header->solidOffset;
+   level->objects = (const LevelRecord*)(level->data + header->objectOffset);
+
+   return 1;
+}
+
+/**
+ * \fn static LevelFile* readLevelFile(FILE* file)
+ * \brief Read a whole cooked level in memory, when it can't be mapped
+ * \return the LevelFile structure, NULL if the file isn't a valid cooked level
+ */
+static LevelFile* readLevelFile(FILE* file) {
+
+   LevelFile* level;
+   long size;
+
+   if(file == NULL || fseek(file, 0, SEEK_END) != 0 || (size = ftell(file)) <= 0 || fseek(file, 0, SEEK_SET) != 0) return NULL;
+
+   if((level = (LevelFile*)malloc(sizeof(LevelFile))) == NULL) return NULL;
+
+   level->size = size;
+   level->mapped = 0;
+
+   if((level->data = (unsigned char*)malloc(size)) == NULL || fread(level->data, 1, size, file) != (size_t)size || checkLevelFile(level) == 0) {
+      free(level->data);
+      free(level);
+
+      return NULL;
+   }
+
+   return level;
+}
+
+/**
+ * \fn static LevelFile* mapLevelFile(const char* levelName)
+ * \brief Map a cooked level in memory, read only
+ * \return the LevelFile structure, NULL if the file doesn't exist or isn't a valid cooked level
+ */
+static LevelFile* mapLevelFile(const char* levelName) {
+
+   LevelFile* level;
+   FILE* file;
+   void* data = NULL;
+   size_t size = 0;
+
+#ifdef _WIN32
+   HANDLE handle, mapping;
+
+   if((handle = CreateFileA(levelName, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL)) == INVALID_HANDLE_VALUE) return NULL;
+
+   size = GetFileSize(handle, NULL);
+
+   /* la vue reste valide une fois les handles fermés */
+   if(size > 0 && size != INVALID_FILE_SIZE && (mapping = CreateFileMappingA(handle, NULL, PAGE_READONLY, 0, 0, NULL)) != NULL) {
+      data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+      CloseHandle(mapping);
+   }
+
+   CloseHandle(handle);
+#else
+   struct stat info;
+   int descriptor;
+
+   if((descriptor = open(levelName, O_RDONLY)) < 0) return NULL;
+
+   if(fstat(descriptor, &info) == 0 && info.st_size > 0) {
+      size = info.st_size;
+
+      if((data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, descriptor, 0)) == MAP_FAILED) data = NULL;
+   }
+
+   close(descriptor);
+#endif
+
+   if(data == NULL) {
+      /* pas de projection : le fichier est lu */
+      file = fopen(levelName, "rb");
+      level = readLevelFile(file);
+
+      if(file != NULL) fclose(file);
+
+      return level;
+   }
+
+   if((level = (LevelFile*)malloc(sizeof(LevelFile))) != NULL) {
+      level->data = (unsigned char*)data;
+      level->size = size;
+      level->mapped = 1;
+
+      if(checkLevelFile(level)) return level;
+   }
+
+   closeLevelFile(level);
+
+#ifdef _WIN32
+   if(level == NULL) UnmapViewOfFile(data);
+#else
+   if(level == NULL) munmap(data, size);
+#endif
+
+   return NULL;
+}
+
+/**
+ * \fn static int getSourceState(const LevelHeader* header, const char* name)
+ * \brief tells if a cooked level was cooked from the current content of its TMX file
+ *
+ * The hash is only computed if the size or the date of the TMX changed.
+ * Without TMX, the cooked level is used as it is.
+ *
+ * \return SOURCE_SAME, SOURCE_CHANGED, or SOURCE_TOUCHED if the content is the same but not the size or the date
+ */
+static int getSourceState(const LevelHeader* header, const char* name) {
+
+   Uint32 size, hash;
+   Uint64 time;
+
+   if(getSourceInfo(name, &size, &time) == 0) return SOURCE_SAME;
+
+   if(size == header->sourceSize && time == header->sourceTime) return SOURCE_SAME;
+
+   if(hashFile(name, &hash) == 0 || hash != header->hash) return SOURCE_CHANGED;
+
+   return SOURCE_TOUCHED;
+}
+
+/**
+ * \fn LevelFile* openLevelFile(const char* name)
+ * \brief Give the cooked level of a TMX file, cooking it first if needed
+ *
+ * \param[in] name: the TMX file
+ * \return the LevelFile structure, NULL if the level couldn't be cooked
+ */
+LevelFile* openLevelFile(const char* name) {
+
+   char levelName[256];
+   LevelFile* level;
+   FILE* file;
+   int state;
+
+   getLevelName(name, levelName, sizeof(levelName));
+
+   if((level = mapLevelFile(levelName)) != NULL) {
+      state = getSourceState(level->header, name);
+
+      /* TMX touché sans être modifié : le .lvl est cuit à nouveau avec sa nouvelle date, sinon son hash serait
+         recalculé à chaque chargement ; le niveau déjà projeté reste valide, même si le .lvl ne peut pas être écrit */
+      if(state == SOURCE_TOUCHED) cookLevel(name);
+
+      if(state != SOURCE_CHANGED) return level;
+   }
+
+   closeLevelFile(level);
+
+   if(cookLevel(name) && (level = mapLevelFile(levelName)) != NULL) return level;
+
+   /* le dossier du niveau n'est pas accessible en écriture */
+   if((file = tmpfile()) == NULL) return NULL;
+
+   level = writeLevel(name, file) ? readLevelFile(file) : NULL;
+
+   fclose(file);
+
+   return level;
+}
+
+/**
+ * \fn void closeLevelFile(LevelFile* level)
+ * \brief Unmap a cooked level and free the LevelFile structure
+ */
+void closeLevelFile(LevelFile* level) {
+
+   if(level == NULL) return;
+
+   if(level->mapped == 0) free(level->data);
+
+#ifdef _WIN32
+   else UnmapViewOfFile(level->data);
+#else
+   else munmap(level->data, level->size);
+#endif
+
+   free(level);
+}
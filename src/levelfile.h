@@ -0,0 +1,77 @@
+/**
+ * \file levelfile.h
+ * \brief header of levelfile.c
+ *
+ * Creation of the LevelHeader, LevelRecord and LevelFile structures.
+ * Declaration of cookLevel(), openLevelFile() and closeLevelFile().
+ *
+ * \author François-Xavier Balu, Gwendal Henry, Martin Parisot, Vincent Werner
+ */
+
+#ifndef LEVELFILE_H_INCLUDED
+#define LEVELFILE_H_INCLUDED
+
+#include "common.h"
+
+/* version du format : un niveau cuit d'une autre version est cuit à nouveau */
+#define LEVEL_FILE_VERSION 2
+
+
+/* début d'un niveau cuit (.lvl), suivi des tiles, de la solidité et des objets */
+typedef struct LevelHeader{
+
+    /* "LVL" */
+    char magic[4];
+    Uint32 version;
+
+    /* TMX d'où le niveau a été cuit : hash FNV-1a de son contenu, et sa taille et sa date
+       pour ne recalculer le hash que si elles ont changé */
+    Uint32 hash;
+    Uint32 sourceSize;
+    Uint64 sourceTime;
+
+    Sint32 sizeX, sizeY;
+    Sint32 objectNumber;
+
+    /* positions des tiles, de la solidité et des objets dans le fichier */
+    Uint32 tileOffset, solidOffset, objectOffset;
+
+}LevelHeader;
+
+
+/* un objet du TMX, avec son groupe (0 s'il n'en a pas) */
+typedef struct LevelRecord{
+
+    Sint32 type, spe, gid, x, y;
+    Sint32 group;
+
+}LevelRecord;
+
+
+typedef struct LevelFile{
+
+    const LevelHeader *header;
+
+    /* tiles rangées par chunk (chunk.h) : celles du chunk i sont les CHUNK_SIZE x CHUNK_SIZE à partir de
+       tiles[i * CHUNK_SIZE * CHUNK_SIZE], ligne par ligne, à 0 hors de la map */
+    const Sint32 *tiles;
+
+    /* 1 pour une tile solide, rangé par chunk comme les tiles : solid[i * CHUNK_SIZE * CHUNK_SIZE] pour le chunk i */
+    const unsigned char *solid;
+
+    const LevelRecord *objects;
+
+    /* le fichier projeté en mémoire, ou lu si la projection a échoué */
+    unsigned char *data;
+    size_t size;
+    int mapped;
+
+}LevelFile;
+
+
+int cookLevel(const char* name);
+LevelFile* openLevelFile(const char* name);
+void closeLevelFile(LevelFile* level);
+
+
+#endif // LEVELFILE_H_INCLUDED
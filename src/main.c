@@ -14,67 +14,191 @@
 #include "object.h"
 #include "menu.h"
 #include "draw.h"
+#include "replay.h"
+#include "bench.h"
+#include "blit.h"
+#include "render.h"
+#include "levelfile.h"
 
 /**
 * \fn int main(int argc, char* argv[])
 * \brief Main function.
 * \param[in] argc Number of argument passed to the program.
 * \param[in] argv Arguments passed to the program.
+*
+* Options:
+* --headless: no window, no font and no sound, frames are run as fast as possible
+* --frames N: number of frames to run in headless mode (HEADLESS_FRAMES by default)
+* --level N: starts directly in the level N, without the start menu
+* --record FILE: records the inputs of the session in FILE (with --replay, the session played, recorded again)
+* --replay FILE: plays again the session recorded in FILE instead of reading the keyboard
+* --bench FILE: plays every level in headless mode and writes the durations of each part of a frame in FILE (JSON)
+* --render-thread: the frames of the levels are drawn by a render thread, while the next one is updated
+* --check-blit: compares alphaBlit() with SDL_BlitSurface() (same pixels and speed) and quits
+*
+* Unless compiled with NDEBUG, a headless run (and --bench) first checks that alphaBlit() gives the same pixels
+* as SDL_BlitSurface() with each blending of the CPU, and stops if it doesn't.
 */
 int main(int argc, char* argv[]) {
 
-   unsigned int frameLimit;
+   unsigned int frameLimit, startTicks;
+   int i, frame = 0, frameMax = 0, level = -1, diverged = -1, renderThread = 0, blitCheck = 0, cook = 0;
+   char *recordPath = NULL, *replayPath = NULL, *benchPath = NULL, map[200];
+   FILE* file;
+   Replay *replay = NULL, *record = NULL;
 
    /*Create the Game structure*/
    Game* game = createGame();
 
+   /* reads the command line options */
+   for(i = 1; i < argc; i++) {
+      if(strcmp(argv[i], "--headless") == 0) {
+         game->headless = 1;
+      } else if(strcmp(argv[i], "--frames") == 0 && i+1 < argc) {
+         frameMax = atoi(argv[++i]);
+      } else if(strcmp(argv[i], "--level") == 0 && i+1 < argc) {
+         level = atoi(argv[++i]);
+      } else if(strcmp(argv[i], "--record") == 0 && i+1 < argc) {
+         recordPath = argv[++i];
+      } else if(strcmp(argv[i], "--replay") == 0 && i+1 < argc) {
+         replayPath = argv[++i];
+      } else if(strcmp(argv[i], "--bench") == 0 && i+1 < argc) {
+         benchPath = argv[++i];
+         game->headless = 1;
+      } else if(strcmp(argv[i], "--render-thread") == 0) {
+         renderThread = 1;
+      } else if(strcmp(argv[i], "--check-blit") == 0) {
+         blitCheck = 1;
+         game->headless = 1;
+      } else if(strcmp(argv[i], "--cook") == 0) {
+         cook = 1;
+      }
+   }
+
+   /* cooks every level of data/map, without starting the game */
+   if(cook) {
+      for(i = 0; i <= LEVEL_MAX; i++) {
+         sprintf(map, "data/map/map%d.tmx", i);
+
+         if((file = fopen(map, "rb")) == NULL) continue;
+         fclose(file);
+
+         if(cookLevel(map)) printf("%s cooked\n", map);
+         else printf("Couldn't cook %s\n", map);
+      }
+
+      destroyGame(game);
+      return EXIT_SUCCESS;
+   }
+
+   if(game->headless && frameMax == 0 && replayPath == NULL && benchPath == NULL) frameMax = HEADLESS_FRAMES;
+
    frameLimit = SDL_GetTicks()+16;
 
    /* initializes SDL */
    initGame("MyLittleProject",game);
 
+   if(blitCheck) {
+      i = checkBlit(1);
+      destroyGame(game);
+      return i ? EXIT_SUCCESS : EXIT_FAILURE;
+   }
+
+#ifndef NDEBUG
+   /* les blits SSE2 et AVX2 doivent rester exacts */
+   if(game->headless && checkBlit(0) == 0) {
+      destroyGame(game);
+      return EXIT_FAILURE;
+   }
+#endif
+
+   if(renderThread) startRenderThread(game);
+
+   if(benchPath != NULL) {
+      i = runBenchmark(game, benchPath, frameMax);
+      destroyGame(game);
+      return i ? EXIT_SUCCESS : EXIT_FAILURE;
+   }
+
+   /* skips the start menu */
+   if(level >= 0) game->level = level;
+   if(level >= 0 || game->headless) game->onMenu = 0;
+
    /* initializes player */
-   initializePlayer(game->player);
+   initializePlayer(game->player, game);
 
    /* loads resources */
    loadGame(game);
 
+   if(replayPath != NULL) {
+      if((replay = loadReplay(replayPath)) == NULL) {
+         destroyGame(game);
+         return EXIT_FAILURE;
+      }
+      startReplay(replay, game);
+   }
+
+   /* a replay is recorded again in its own Replay, with the hashes of this build */
+   if(recordPath != NULL) {
+      if((record = createReplay()) == NULL) {
+         destroyReplay(replay);
+         destroyGame(game);
+         return EXIT_FAILURE;
+      }
+      startRecording(record, game);
+   }
+
+   startTicks = SDL_GetTicks();
+
    /* Main loop */
    while(game->go == 1) {
+      /* nothing moves on a menu already shown: sleeps until a key is pressed */
+      if(game->onMenu && game->menuOnScreen && game->headless == 0 && replayPath == NULL) {
+         waitInput();
+      }
+
       /* reads input from keyboard */
       getInput(game->input, game);
 
-      /* checks if menu is used */
-      if(game->onMenu == 0) {
-         /* updates game */
-         updatePlayer(game->player,game);
-         updateObject(game);
+      /* the recorded inputs replace the keyboard */
+      if(replayPath != NULL && getReplayInput(replay, game->input) == 0) {
+         break;
+      }
 
-         /* displays everything */
-         draw(game);
+      if(record != NULL) recordInput(record, game->input);
 
-      } else {
-         switch(game->menuType) {
+      /* updates and displays the level or the menu */
+      updateGame(game);
 
-         case START :
-            updateStartMenu(game->input,game);
-            drawStartMenu(game); // ya un bug ici !
-            break;
+      if(record != NULL) recordHash(record, game);
 
-         case SELECT_LEVEL :
-            updateSelectLevelMenu(game->input,game);
-            drawSelectLevelMenu(game);
+      if(replayPath != NULL && diverged < 0 && checkReplayHash(replay, game) == 0) {
+         diverged = frame;
+         printf("replay diverged at frame %d\n", frame);
+      }
 
-         }
+      frame++;
+
+      if(game->headless) {
+         /* no frame cap, stops after frameMax frames or at the end of the level */
+         if(frame == frameMax) game->go = 0;
+      } else {
+         /*set the framerate at 60 FPS*/
+         delay(frameLimit);
+         frameLimit = SDL_GetTicks()+16;
       }
+   }
 
-      /*set the framerate at 60 FPS*/
-      delay(frameLimit);
-      frameLimit = SDL_GetTicks()+16;
+   if(game->headless) {
+      printf("%d frames in %u ms\n", frame, SDL_GetTicks() - startTicks);
    }
 
+   if(record != NULL) saveReplay(record, recordPath);
+   destroyReplay(record);
+   destroyReplay(replay);
+
    /*free everything*/
    destroyGame(game);
 
-   return EXIT_SUCCESS;
+   return diverged < 0 ? EXIT_SUCCESS : EXIT_FAILURE;
 }
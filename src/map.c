@@ -9,36 +9,84 @@
 #include "player.h"
 #include "draw.h"
 #include "object.h"
+#include "monster.h"
+#include "render.h"
+#include "scrollcache.h"
+#include "objectbatch.h"
+#include "trigger.h"
+#include "snapshot.h"
+#include "preload.h"
+#include "arena.h"
+#include "chunk.h"
+#include "levelfile.h"
 
 
 /**
  * \fn Map* createMap()
  * \brief Create the Map structure
  *
- * the Map structure is allocated and initialized.
+ * the Map structure is allocated and initialized, with the arena of the data of the levels.
  * If the allocation failed the function returns NULL.
  */
 Map* createMap() {
 
    Map* map;
+   int i;
 
    if((map = (Map*)malloc(sizeof(Map))) == NULL) {
       fprintf(stderr, "can't allocate memory for a Map\n");
    }
+   else if((map->arena = createArena(LEVEL_ARENA_SIZE)) == NULL) {
+      free(map);
+      map = NULL;
+   }
+   else if((map->chunks = createChunkStream(map)) == NULL) {
+      destroyArena(map->arena);
+      free(map);
+      map = NULL;
+   }
+   else if((map->preload = createLevelPreload()) == NULL) {
+      destroyChunkStream(map->chunks);
+      destroyArena(map->arena);
+      free(map);
+      map = NULL;
+   }
    else {
 
       map->background = NULL;
-      map->xmlLevel = NULL;
       map->tileSet = NULL;
       map->backgroundMenu = NULL;
+      map->tileOpacity = NULL;
+      map->tileNumber = 0;
+      map->tileSetOpaque = NULL;
+      map->scrollCache = NULL;
       map->startX = 0;
       map->startY = 0;
       map->maxX = 0;
       map->maxY = 0;
       map->sizeX = 0;
       map->sizeY = 0;
-      map->objects = NULL;
-      map->tile = NULL;
+      for(i = 0; i < OBJECT_TYPES; i++) {
+         map->batches[i].x = NULL;
+         map->batches[i].number = 0;
+      }
+      map->monsters = NULL;
+      map->monsterNumber = 0;
+      map->monsterBatch.x = NULL;
+      map->monsterBatch.number = 0;
+      map->objectType = NULL;
+      map->objectSlot = NULL;
+      map->generation = 0;
+      map->levelFile = NULL;
+      map->groupBlocks = NULL;
+      map->groupStart = NULL;
+      map->groupColor = NULL;
+      map->groupNumber = 0;
+      map->triggers = NULL;
+      map->blockTiles = NULL;
+      map->blockSolid = NULL;
+      map->blockTileNumber = 0;
+      map->snapshot = NULL;
    }
 
    return map;
@@ -47,76 +95,112 @@ Map* createMap() {
 
 /**
  * \fn void loadMap (char* name, Map* map, Game* game)
- * \brief Load the level from a XML file.
+ * \brief Load the level from a TMX file.
  *
- * \param[in] name : name of the XML file
+ * \param[in] name : name of the TMX file
  * \param[in] map : strores the informations of the level
  * \param[in] game : poiter to the Game structure
  *
- * The function load the level from a XML file and strores them in the Map structure.
- * The function parse the XML file, fill the tile table, and then the list of the Objects.
+ * The level is read from its cooked file (levelfile.h), mapped in memory, which is cooked again
+ * if the TMX file changed. If the level was asked in advance (preload.h), the file already opened by the thread is taken. The function fills the list of the Objects.
+ * The tiles and their solidity are only copied by chunks around the camera (chunk.h).
  */
 void loadMap (char* name, Map* map, Game* game) {
 
-   /*Parse the XML file*/
-   map->xmlLevel = loadXMLFile(name);
+   const LevelHeader* header;
+   const LevelRecord* record;
+   int i;
 
-   int sizeX = atoi(map->xmlLevel->root->attr->next->next->value); //a toi de jouer !
-   int sizeY = atoi(map->xmlLevel->root->attr->next->next->next->value); //échec et mat !n
+   /* le thread des chunks ne doit plus lire le niveau précédent */
+   stopChunkStream(map->chunks);
+   closeLevelFile(map->levelFile);
 
+   /* les données du niveau précédent sont rendues d'un coup, celles du nouveau prennent leur place */
+   resetArena(map->arena);
 
-   int i,j;
+   /* les tiles en cache sont celles du niveau précédent */
+   invalidateScrollCache(map->scrollCache);
 
-   /*Find the size of the level*/
-   map->maxX = (sizeX)*TILE_SIZE;
-   map->maxY = (sizeY)*TILE_SIZE;
-   map->sizeX = sizeX;
-   map->sizeY = sizeY;
-   map->startX = map->startY = 0;
-
+   if((map->levelFile = takePreloadedLevel(map->preload, name)) == NULL && (map->levelFile = openLevelFile(name)) == NULL) {
+      printf("Couldn't load the level %s\n", name);
+      exit(1);
+   }
 
-   /*Fill the tile table*/
-   map->tile = (int**) malloc((map->sizeY)*sizeof(int*));
+   header = map->levelFile->header;
 
-   for(i=0 ; i<map->sizeX; i++) {
-      map->tile[i] = (int*) malloc(map->sizeX*sizeof(int));
-   }
-
+   /*Find the size of the level*/
+   map->sizeX = header->sizeX;
+   map->sizeY = header->sizeY;
+   map->maxX = map->sizeX * TILE_SIZE;
+   map->maxY = map->sizeY * TILE_SIZE;
+   map->startX = map->startY = 0;
+
+   /* les tiles et leur solidité ne sont lues que par chunks, autour de la caméra */
+   if(startChunkStream(map->chunks, map->levelFile) == 0) {
+      printf("Couldn't allocate the chunks of %s\n", name);
+      exit(1);
+   }
 
-   XML_Node* tileLayer = map->xmlLevel->root->first->next->next;
+   /*Fill the table of the Objects*/
+   game->objectNumber = header->objectNumber;
+
+   GameObject* objects = (GameObject*) arenaAlloc(map->arena, (game->objectNumber + 1)*sizeof(GameObject));
+   int* groups = (int*) arenaAlloc(map->arena, (game->objectNumber + 1)*sizeof(int));
 
-   for(i=0 ; i<map->sizeY ; i++) {
-      for(j=0 ; j<map->sizeX ; j++) {
-
+   if(objects == NULL || groups == NULL) {
+      printf("Couldn't allocate the %d objects of %s\n", game->objectNumber, name);
+      exit(1);
+   }
 
-         map->tile[i][j] = atoi(tileLayer->first->current->attr->value);
+   for(i=0 ; i<game->objectNumber; i++) {
 
-         tileLayer->first->current = tileLayer->first->current->next;
-      }
+      record = &map->levelFile->objects[i];
 
+      objects[i].type = record->type;
+      objects[i].spe = record->spe;
+      objects[i].gid = record->gid;
+      objects[i].x = record->x;
+      objects[i].y = record->y;
+      objects[i].initialized = 0;
+      groups[i] = record->group;
    }
 
-   /*Find the number of objects in the level*/
-   XML_Node* objectLayer = map->xmlLevel->root->last;
+   /* les objets immobiles rangés par type, et les monstres à part */
+   fillObjectBatches(map, objects, groups, game->objectNumber);
 
-   game->objectNumber = objectLayer->cc;
+   /* les blocs commandés par chaque interrupteur */
+   buildSwitchGroups(map);
 
-   /*Fill the table of the Objects*/
-   map->objects = (GameObject*) malloc(game->objectNumber*sizeof(GameObject));
+   /* les blocs solides au début du niveau, puis les patrouilles des monstres sur les tiles et ces blocs */
+   placeSolidBlocks(map);
 
-   for(i=0 ; i<game->objectNumber; i++) {
+   for(i=0 ; i<map->monsterNumber; i++) computePatrolExtents(&(map->monsters[i]), map);
 
-      map->objects[i].type = atoi(objectLayer->current->attr->value);
-      map->objects[i].spe = atoi(objectLayer->current->attr->next->value);
-      map->objects[i].gid = atoi(objectLayer->current->attr->next->next->value);
-      map->objects[i].x = atoi(objectLayer->current->attr->next->next->next->value);
-      map->objects[i].y = atoi(objectLayer->current->attr->next->next->next->next->value);
-      map->objects[i].initialized = 0;
+   /* les objets immobiles ne sont évalués que quand le joueur est dans leurs tiles */
+   buildObjectTriggers(map);
 
-      objectLayer->current = objectLayer->current->next;
+   /* l'état du début du niveau, remis quand il recommence après un game over */
+   map->snapshot = createLevelSnapshot(map, game->level);
+}
+
+
+/**
+ * \fn int isSolidTile(Map* map, int x, int y)
+ * \brief tells if a tile is solid
+ *
+ * \param[in] map
+ * \param[in] x: column of the tile
+ * \param[in] y: row of the tile
+ *
+ * Returns 1 if the tile is solid or has a solid block on it, 0 if it is not or if it is outside the map.
+ */
+int isSolidTile(Map* map, int x, int y) {
 
+   if(x < 0 || x >= map->sizeX || y < 0 || y >= map->sizeY) {
+      return 0;
    }
-   checkAllocatedMemory(LOG_TYPE );
+
+   return getSolidity(map, x, y) || hasSolidBlock(map, x, y);
 }
 
 
@@ -160,14 +244,14 @@ void mapCollision(GameObject *entity, Map *map, Game* game) {
       //De là, on va tester les mouvements initiés dans updatePlayer grâce aux vecteurs
       //dirX et dirY, tout en testant avant qu'on se situe bien dans les limites de l'écran.
 
-      if (x1 >= 0 && x2 < map->maxX && y1 >= 0 && y2 < map->maxY) {
+      if (x1 >= 0 && x2 < map->sizeX && y1 >= 0 && y2 < map->sizeY) {
          //Si on a un mouvement à droite
 
          if (entity->dirX > 0) {
 
             //On vérifie si les tiles recouvertes sont solides
 
-            if (map->tile[y1][x2] > BLANK_TILE || map->tile[y2][x2] > BLANK_TILE) {
+            if (isSolidTile(map, x2, y1) || isSolidTile(map, x2, y2)) {
                // Si c'est le cas, on place le joueur aussi près que possible
                // de ces tiles, en mettant à jour ses coordonnées. Enfin, on réinitialise
                //son vecteur déplacement (dirX).
@@ -188,7 +272,7 @@ void mapCollision(GameObject *entity, Map *map, Game* game) {
 
 
 
-            if ( map->tile[y1][x1] > BLANK_TILE ||  map->tile[y2][x1] > BLANK_TILE) {
+            if ( isSolidTile(map, x1, y1) ||  isSolidTile(map, x1, y2)) {
 
                entity->x = (x1 + 1) * TILE_SIZE;
 
@@ -227,13 +311,13 @@ void mapCollision(GameObject *entity, Map *map, Game* game) {
       y1 = (entity->y + entity->dirY) / TILE_SIZE;
       y2 = (entity->y + entity->dirY + entity->h) / TILE_SIZE;
 
-      if (x1 >= 0 && x2 < map->maxX && y1 >= 0 && y2 < map->maxY) {
+      if (x1 >= 0 && x2 < map->sizeX && y1 >= 0 && y2 < map->sizeY) {
          if (entity->dirY > 0) {
             /* Déplacement en bas */
 
 
 
-            if ( map->tile[y2][x1] > BLANK_TILE || map->tile[y2][x2] > BLANK_TILE) {
+            if ( isSolidTile(map, x1, y2) || isSolidTile(map, x2, y2)) {
                //Si la tile est solide, on y colle le joueur et
                //on le déclare sur le sol (onGround).
                entity->y = y2 * TILE_SIZE;
@@ -252,7 +336,7 @@ void mapCollision(GameObject *entity, Map *map, Game* game) {
 
 
 
-            if ( map->tile[y1][x1] > BLANK_TILE ||  map->tile[y1][x2] > BLANK_TILE) {
+            if ( isSolidTile(map, x1, y1) ||  isSolidTile(map, x2, y1)) {
 
                entity->y = (y1 + 1) * TILE_SIZE;
 
@@ -298,16 +382,172 @@ void mapCollision(GameObject *entity, Map *map, Game* game) {
 }
 
 
+/**
+ * \fn void classifyTiles(Map* map)
+ * \brief finds which tiles of the tileset are opaque, transparent or both
+ *
+ * \param[in, out] map: its tileset must be loaded.
+ *
+ * Each tile is TILE_OPAQUE if every pixel is opaque, TILE_TRANSPARENT if every pixel is
+ * transparent and TILE_MIXED otherwise. drawMap() skips the transparent tiles and copies the opaque
+ * ones from map->tileSetOpaque without blending, drawBackground() doesn't draw the background under them.
+ */
+void classifyTiles(Map* map) {
+
+   SDL_Surface* tileSet = map->tileSet;
+   Uint32 *pixels, alpha;
+   int i, x, y, x0, y0, opaque, transparent, opaqueNumber = 0;
+
+   free(map->tileOpacity);
+   freeImage(map->tileSetOpaque);
+   map->tileOpacity = NULL;
+   map->tileSetOpaque = NULL;
+   map->tileNumber = 0;
+
+   if(tileSet == NULL) return;
+
+   /* 10 tiles par ligne, comme dans drawMap() */
+   if((map->tileOpacity = (unsigned char*)malloc(10 * (tileSet->h / TILE_SIZE))) == NULL) {
+      fprintf(stderr, "can't allocate memory for the opacity of the tiles\n");
+
+      return;
+   }
+
+   map->tileNumber = 10 * (tileSet->h / TILE_SIZE);
+
+   if(SDL_MUSTLOCK(tileSet)) SDL_LockSurface(tileSet);
+
+   for(i = 0; i < map->tileNumber; i++) {
+      x0 = i % 10 * TILE_SIZE;
+      y0 = i / 10 * TILE_SIZE;
+
+      if(tileSet->format->BytesPerPixel != 4 || x0 + TILE_SIZE > tileSet->w) {
+         map->tileOpacity[i] = TILE_MIXED;
+         continue;
+      }
+
+      opaque = 1;
+      transparent = (tileSet->format->Amask != 0);
+
+      for(y = y0; y < y0 + TILE_SIZE && (opaque || transparent) && tileSet->format->Amask != 0; y++) {
+         pixels = (Uint32*)((Uint8*)tileSet->pixels + y * tileSet->pitch);
+
+         for(x = x0; x < x0 + TILE_SIZE; x++) {
+            alpha = pixels[x] & tileSet->format->Amask;
+
+            if(alpha != 0) transparent = 0;
+            if(alpha != tileSet->format->Amask) opaque = 0;
+         }
+      }
+
+      map->tileOpacity[i] = opaque ? TILE_OPAQUE : (transparent ? TILE_TRANSPARENT : TILE_MIXED);
+
+      if(opaque) opaqueNumber++;
+   }
+
+   if(SDL_MUSTLOCK(tileSet)) SDL_UnlockSurface(tileSet);
+
+   if(opaqueNumber > 0) map->tileSetOpaque = copyOpaqueImage(tileSet);
+}
+
+
+/**
+ * \fn void drawBackground(Map* map, Game* game)
+ * \brief displays the background, except under the opaque tiles
+ *
+ * \param[in] map
+ * \param[in] game
+ *
+ * The screen is cut in rows of tiles. Consecutive rows covered at the same columns are drawn together,
+ * one blit for each group of uncovered columns.
+ */
+void drawBackground(Map* map, Game* game) {
+
+   Uint32 covered[SCREEN_HEIGHT / TILE_SIZE + 2];
+   TileSpan spans[SCREEN_WIDTH / TILE_SIZE + 2];
+   SDL_Rect src, dest;
+   int x1, y1, row, rows, last, column, columns, first, mapX, mapY, a, i, number, top, bottom, left, right;
+
+   if(map->background == NULL) return;
+
+   if(map->tileOpacity == NULL) {
+      drawImage(map->background, 0, 0, game);
+
+      return;
+   }
+
+   /* les tiles visibles, comme dans drawMap() */
+   x1 = (map->startX % TILE_SIZE) * -1;
+   y1 = (map->startY % TILE_SIZE) * -1;
+   columns = (SCREEN_WIDTH - x1 + TILE_SIZE - 1) / TILE_SIZE;
+   rows = (SCREEN_HEIGHT - y1 + TILE_SIZE - 1) / TILE_SIZE;
+
+   /* un bit par colonne couverte par une tile opaque */
+   for(row = 0; row < rows; row++) {
+      covered[row] = 0;
+      mapY = map->startY / TILE_SIZE + row;
+
+      number = getTileSpans(map, mapY, map->startX / TILE_SIZE, map->startX / TILE_SIZE + columns, spans, SCREEN_WIDTH / TILE_SIZE + 2);
+
+      for(i = 0; i < number; i++) {
+         for(mapX = spans[i].start; mapX < spans[i].end; mapX++) {
+            a = getTile(map, mapX, mapY) - 1;
+
+            if(a < map->tileNumber && map->tileOpacity[a] == TILE_OPAQUE) covered[row] |= 1u << (mapX - map->startX / TILE_SIZE);
+         }
+      }
+   }
+
+   for(row = 0; row < rows; row = last + 1) {
+      for(last = row; last + 1 < rows && covered[last + 1] == covered[row]; last++);
+
+      top = y1 + row * TILE_SIZE;
+      bottom = y1 + (last + 1) * TILE_SIZE;
+      if(top < 0) top = 0;
+      if(bottom > map->background->h) bottom = map->background->h;
+
+      for(column = 0; column < columns; ) {
+         if(covered[row] & (1u << column)) {
+            column++;
+            continue;
+         }
+
+         for(first = column; column < columns && (covered[row] & (1u << column)) == 0; column++);
+
+         left = x1 + first * TILE_SIZE;
+         right = x1 + column * TILE_SIZE;
+         if(left < 0) left = 0;
+         if(right > map->background->w) right = map->background->w;
+
+         if(right <= left || bottom <= top) continue;
+
+         src.x = dest.x = left;
+         src.y = dest.y = top;
+         src.w = dest.w = right - left;
+         src.h = dest.h = bottom - top;
+
+         drawSurface(map->background, &src, &dest, game);
+      }
+   }
+}
+
+
 /**
  * \fn void drawMap(Map* map, Game* game)
- * \brief
+ * \brief displays the tiles visible on the screen
  *
  * \param[in] map
  * \param[in] game
+ *
+ * The tiles are taken from the scroll cache when there is one, drawn one by one otherwise.
  */
 void drawMap(Map* map, Game* game) {
 
-   int x, y, mapX, x1, x2, mapY, y1, y2, xsource, ysource, a;
+   TileSpan spans[SCREEN_WIDTH / TILE_SIZE + 2];
+   int x, y, mapX, x1, x2, mapY, y1, y2, xsource, ysource, a, opacity, i, first, number, columns;
+
+   /* les tiles déjà en cache ne sont pas redessinées */
+   if(map->scrollCache != NULL && drawScrollCache(map->scrollCache, map, game)) return;
 
    /*Gestion du scrolling*/
 
@@ -331,35 +571,41 @@ void drawMap(Map* map, Game* game) {
    A chaque fois, on rajoute TILE_SIZE (donc 70), car on descend d'une ligne
    de tile (qui fait 70 pixels de hauteur) */
 
-   for (y = y1; y < y2; y += TILE_SIZE) {
-      /* A chaque début de ligne, on réinitialise mapX qui contient la colonne
-      (0 au début puisqu'on ne scrolle pas) */
+   columns = (x2 - x1) / TILE_SIZE;
+
+   for (y = y1; y < y2 && mapY < map->sizeY; y += TILE_SIZE) {
+      /* Seuls les groupes de tiles non vides de la ligne sont parcourus,
+      limités aux colonnes visibles */
 
-      mapX = map->startX / TILE_SIZE;
+      number = getTileSpans(map, mapY, mapX, mapX + columns, spans, SCREEN_WIDTH / TILE_SIZE + 2);
 
-      /* A chaque colonne de tile, on dessine la bonne tile en allant
-      de x = 0 à x = 1050*/
+      for (i = 0; i < number; i++) {
 
-      for (x = x1; x < x2; x += TILE_SIZE) {
+         first = spans[i].start;
 
-         /* Suivant le numéro de notre tile, on découpe le tileset */
+         for (x = x1 + (first - mapX) * TILE_SIZE; first < spans[i].end; first++, x += TILE_SIZE) {
 
-         a = map->tile[mapY][mapX]-1;
+            /* Suivant le numéro de notre tile, on découpe le tileset */
 
-         /* Calcul pour obtenir son y (pour un tileset de 10 tiles
-         par ligne, d'où le 10 */
+            a = getTile(map, first, mapY)-1;
 
-         ysource = a / 10 * TILE_SIZE;
+            /* les tiles opaques sont copiées sans mélange */
+            opacity = a < map->tileNumber ? map->tileOpacity[a] : TILE_MIXED;
 
-         /* Et son x */
+            /* Calcul pour obtenir son y (pour un tileset de 10 tiles
+            par ligne, d'où le 10 */
 
-         xsource = a % 10 * TILE_SIZE;
+            ysource = a / 10 * TILE_SIZE;
 
-         /* Fonction qui blitte la bonne tile au bon endroit */
+            /* Et son x */
 
-         drawTile(map->tileSet, x, y, xsource, ysource, game);
+            xsource = a % 10 * TILE_SIZE;
 
-         mapX++;
+            /* Fonction qui blitte la bonne tile au bon endroit */
+
+            drawTile(opacity == TILE_OPAQUE && map->tileSetOpaque != NULL ? map->tileSetOpaque : map->tileSet,
+                     x, y, xsource, ysource, game);
+         }
       }
 
       mapY++;
@@ -394,11 +640,11 @@ void monsterCollisionToMap(GameObject* entity, Map* map) {
       y1 = (entity->y) / TILE_SIZE;
       y2 = (entity->y + i - 1) / TILE_SIZE;
 
-      if (x1 >= 0 && x2 < map->maxX && y1 >= 0 && y2 < map->maxY) {
+      if (x1 >= 0 && x2 < map->sizeX && y1 >= 0 && y2 < map->sizeY) {
          //Si on a un mouvement à droite
          if (entity->dirX > 0) {
             //On vérifie si les tiles recouvertes sont solides
-            if (map->tile[y1][x2] > BLANK_TILE || map->tile[y2][x2] > BLANK_TILE) {
+            if (isSolidTile(map, x2, y1) || isSolidTile(map, x2, y2)) {
                entity->x = x2 * TILE_SIZE;
                entity->x -= entity->w + 1;
                entity->dirX = 0;
@@ -410,7 +656,7 @@ void monsterCollisionToMap(GameObject* entity, Map* map) {
          //Même chose à gauche
          else if (entity->dirX < 0) {
 
-            if (map->tile[y1][x1] > BLANK_TILE || map->tile[y2][x1] > BLANK_TILE) {
+            if (isSolidTile(map, x1, y1) || isSolidTile(map, x1, y2)) {
                entity->x = (x1 + 1) * TILE_SIZE;
                entity->dirX = 0;
             }
@@ -446,12 +692,12 @@ void monsterCollisionToMap(GameObject* entity, Map* map) {
       y1 = (entity->y + entity->dirY) / TILE_SIZE;
       y2 = (entity->y + entity->dirY + entity->h) / TILE_SIZE;
 
-      if (x1 >= 0 && x2 < map->maxX && y1 >= 0 && y2 < map->maxY) {
+      if (x1 >= 0 && x2 < map->sizeX && y1 >= 0 && y2 < map->sizeY) {
          if (entity->dirY > 0) {
 
             /* Déplacement en bas */
 
-            if (map->tile[y2][x1] > BLANK_TILE || map->tile[y2][x2] > BLANK_TILE) {
+            if (isSolidTile(map, x1, y2) || isSolidTile(map, x2, y2)) {
                entity->y = y2 * TILE_SIZE;
                entity->y -= entity->h;
                entity->dirY = 0;
@@ -464,7 +710,7 @@ void monsterCollisionToMap(GameObject* entity, Map* map) {
 
             /* Déplacement vers le haut */
 
-            if (map->tile[y1][x1] > BLANK_TILE || map->tile[y1][x2] > BLANK_TILE) {
+            if (isSolidTile(map, x1, y1) || isSolidTile(map, x2, y1)) {
                entity->y = (y1 + 1) * TILE_SIZE;
                entity->dirY = 0;
             }
@@ -511,21 +757,22 @@ void monsterCollisionToMap(GameObject* entity, Map* map) {
 void destroyMap(Map* map) {
 
 
-   int i;
-
-
    if(map != NULL) {
 
-      destroyXMLFile(map->xmlLevel);
-      SDL_FreeSurface(map->background);
-      SDL_FreeSurface(map->backgroundMenu);
-      SDL_FreeSurface(map->tileSet);
+      releaseImage(map->background);
+      releaseImage(map->backgroundMenu);
+      releaseImage(map->tileSet);
+      freeImage(map->tileSetOpaque);
+      free(map->tileOpacity);
+      destroyScrollCache(map->scrollCache);
 
-      for(i=0; i<map->sizeY; i++) {
-         free(map->tile[i]);
-      }
+      /* le thread des chunks lit encore les données du niveau */
+      destroyChunkStream(map->chunks);
+      closeLevelFile(map->levelFile);
+      destroyLevelPreload(map->preload);
 
-      free(map->objects);
+      /* toutes les données du niveau */
+      destroyArena(map->arena);
       free(map);
 
    }
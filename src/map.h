@@ -3,10 +3,18 @@
 
 #include "game.h"
 
+/* opacité d'une tile du tileset */
+#define TILE_TRANSPARENT 0
+#define TILE_MIXED 1
+#define TILE_OPAQUE 2
+
 
 
 void loadMap (char* name, Map* map, Game* game);
+int isSolidTile(Map* map, int x, int y);
 void mapCollision(GameObject *entity, Map *map, Game* game);
+void classifyTiles(Map* map);
+void drawBackground(Map* map, Game* game);
 void drawMap(Map* map, Game* game);
 void monsterCollisionToMap(GameObject* entity, Map* map);
 Map* createMap();
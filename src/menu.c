@@ -9,6 +9,8 @@
 #include "map.h"
 #include "player.h"
 #include "draw.h"
+#include "render.h"
+#include "preload.h"
 
 
 /**
@@ -116,6 +118,12 @@ void updateSelectLevelMenu(Input* input, Game* game) {
       input->up = 0;
    }
 
+   /* le niveau en surbrillance est ouvert d'avance, rien n'est fait s'il l'est déjà */
+   if(game->choice != 9){
+      sprintf(level, "data/map/map%d.tmx", game->choice);
+      preloadLevel(game->map->preload, level);
+   }
+
    /*select level or back to the start menu*/
    if(input->enter){
 
@@ -129,7 +137,7 @@ void updateSelectLevelMenu(Input* input, Game* game) {
         game->level = game->choice;
         game->choice = 0;
         game->onMenu = 0;
-        initializePlayer(game->player);
+        initializePlayer(game->player, game);
         sprintf(level, "data/map/map%d.tmx", game->level );
         loadMap(level, game->map, game);
 
@@ -167,21 +175,79 @@ void drawTileMenu(SDL_Surface *image,int x, int y , int frameNumber, Game* game)
    src.h = image->h;
    src.w = 190;
 
-   SDL_BlitSurface(image, &src, game->screen, &dest);
+   drawSurface(image, &src, &dest, game);
+}
+
+
+/**
+ * \fn static int beginMenuLayer(Game* game, SDL_Surface** screen)
+ * \brief prepares the drawing of a menu
+ *
+ * \param[in, out] game
+ * \param[out] screen: the screen, to give back to endMenuLayer()
+ *
+ * Returns 0 when the menu on the screen is already the right one, nothing has to be drawn.
+ * Returns 1 when the layer of the menu is already composed and only has to be shown.
+ * Returns 2 when the menu has to be composed: the drawing functions then draw into the layer.
+ */
+static int beginMenuLayer(Game* game, SDL_Surface** screen) {
+
+   *screen = game->screen;
+
+   if(game->menuLayerType == game->menuType && game->menuLayerChoice == game->choice) {
+      if(game->menuOnScreen) return 0;
+      if(game->menuLayer != NULL) return 1;
+   }
+
+   if(game->menuLayer == NULL) game->menuLayer = SDL_DisplayFormat(game->screen);
+
+   /* sans calque, on dessine directement à l'écran */
+   if(game->menuLayer != NULL) game->screen = game->menuLayer;
+
+   return 2;
 }
 
+/**
+ * \fn static void endMenuLayer(Game* game, SDL_Surface* screen)
+ * \brief shows the layer of the menu on the screen
+ *
+ * \param[in, out] game
+ * \param[in] screen: the screen given by beginMenuLayer()
+ */
+static void endMenuLayer(Game* game, SDL_Surface* screen) {
+
+   game->screen = screen;
+
+   game->menuLayerType = game->menuType;
+   game->menuLayerChoice = game->choice;
+
+   if(game->menuLayer != NULL) drawImage(game->menuLayer, 0, 0, game);
+
+   presentScreen(game);
+   game->menuOnScreen = 1;
+}
 
 /**
- * \fn int main(int argc, char* argv[])
- * \brief Main function.
+ * \fn void drawStartMenu(Game* game)
+ * \brief Draw the start menu
  *
  * \param[in] game
  *
+ * The menu is only drawn again when the choice changes.
  */
 void drawStartMenu(Game* game) {
 
    //On crée une varuiable qui contiendra notre texte
    char text[200];
+   SDL_Surface* screen;
+
+   switch(beginMenuLayer(game, &screen)) {
+   case 0:
+      return;
+   case 1:
+      endMenuLayer(game, screen);
+      return;
+   }
 
    drawImage(game->map->backgroundMenu, 0, 0, game);
 
@@ -215,24 +281,33 @@ void drawStartMenu(Game* game) {
 
    //drawTileMenu(game->tileMenu,430,350,1, game);
 
-   SDL_Flip(game->screen);
-   SDL_Delay(1);
-
+   endMenuLayer(game, screen);
 }
 
 /**
  * \fn void drawSelectLevelMenu(Game* game)
- * \brief
+ * \brief Draw the menu to select a level
  *
  * \param[in] game
  *
+ * The menu is only drawn again when the choice changes.
  */
 void drawSelectLevelMenu(Game* game) {
 
-   drawImage(game->map->backgroundMenu, 0, 0, game);
    int i;
    int x;
    int y;
+   SDL_Surface* screen;
+
+   switch(beginMenuLayer(game, &screen)) {
+   case 0:
+      return;
+   case 1:
+      endMenuLayer(game, screen);
+      return;
+   }
+
+   drawImage(game->map->backgroundMenu, 0, 0, game);
 
    for (i=0 ; i<9 ; i++){
 
@@ -254,7 +329,7 @@ void drawSelectLevelMenu(Game* game) {
    }
    drawString("BACK", 470, 630, 255, 255, 255, game->fontMenu, game);
 
-   SDL_Flip(game->screen);
+   endMenuLayer(game, screen);
 }
 
 /**
@@ -281,5 +356,5 @@ void drawTileSelectLevel(Game* game, int x, int y, int selected) {
    src.w = 100;
    src.h = 100;
 
-   SDL_BlitSurface(game->tileSelectLevel, &src, game->screen, &dest);
+   drawSurface(game->tileSelectLevel, &src, &dest, game);
 }
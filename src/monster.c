@@ -2,7 +2,7 @@
  * \file monster.c
  * \brief this file contains necessary function to initialize and manage the monsters
  *
- *  Implementation of initializeMonster(), collide(), updateMonsters(), checkFall()
+ *  Implementation of initializeMonster(), collide(), updateMonsters(), touchMonsters(), computePatrolExtents(), updatePatrolExtents()
  *
  * \author François-Xavier Balu, Gwendal Henry, Martin Parisot, Vincent Werner
  */
@@ -14,27 +14,26 @@
 #include "map.h"
 #include "animation.h"
 #include "menu.h"
+#include "objectbatch.h"
 
 /**
- * \fn void void initializeMonster(GameObject* monster, int x, int y)
+ * \fn void void initializeMonster(GameObject* monster, int x, int y, Game* game)
  * \brief initialize a given monster at the given coordinates on the map
  *
- * \param[in, out] monster: contains the sprite, direction, and position of the monster, as well as the necessaries informations for the animation
+ * \param[in, out] monster: contains the animation, direction, and position of the monster, as well as the necessaries informations for the animation
  * \param[in] x,y: coordinates of where to place the monster
+ * \param[in] game: containins the atlas, for the animation
  *
- * This function charges the sprite of the monster into the GameObject corresponding, sets the direction, the coordinates and the parameters for animation (frameNumber and frameTimer)
+ * This function sets the animation of the monster, the direction, the coordinates and the parameters for animation (frameNumber and frameTimer)
  */
-void initializeMonster(GameObject* monster, int x, int y){
+void initializeMonster(GameObject* monster, int x, int y, Game* game){
 
-    monster->sprite = loadImage("data/graphics/flyleft.png");
+    changeAnimation(monster, CLIP_FLY_LEFT, game);
 
     monster->direction = LEFT;
 
-    monster->frameNumber = 0;
-    monster->frameTimer = TIME_BETWEEN_2_FRAMES;
-
-    monster->w = 75;
-    monster->h = 36+40;
+    monster->w = MONSTER_WIDTH;
+    monster->h = MONSTER_HEIGHT;
 
     monster->dirX = 0;
     monster->dirY = 0;
@@ -44,6 +43,7 @@ void initializeMonster(GameObject* monster, int x, int y){
 
     monster->timerMort = 0;
     monster->onGround = 0;
+    monster->etat = ALIVE;
 
     monster->initialized = 1;
 
@@ -74,6 +74,27 @@ int collide(GameObject* player,GameObject* monster){
     else return 1;
 }
 
+/**
+ * \fn static void fallMonster(GameObject* monster, Game* game)
+ * \brief makes a dead monster fall during one frame, until it disappears
+ */
+static void fallMonster(GameObject* monster, Game* game){
+
+    changeAnimation(monster, CLIP_FLY_DEAD, game);
+
+    monster->y += 10;
+
+    monster->timerMort --;
+
+    if(monster->timerMort == 0)
+    {
+        monster->etat = ALIVE;
+
+        monster->initialized = 2;
+
+    }
+}
+
 /**
  * \fn void updateMonsters(Game* game, GameObject* monster)
  * \brief keeps the position and state of the monsters updated
@@ -82,6 +103,7 @@ int collide(GameObject* player,GameObject* monster){
  * \param[in, out] monster: structure containing informations about the monsters
  *
  * This function update the monsters positions and apply the gravity, and make them fall if they're dead.
+ * The player is touched by touchMonsters(), once every monster moved.
  */
 void updateMonsters(Game* game, GameObject* monster){
 
@@ -92,27 +114,57 @@ void updateMonsters(Game* game, GameObject* monster){
 
         if(monster->dirY >= MAX_FALL_SPEED) monster->dirY = MAX_FALL_SPEED;
 
-        if(monster->x == monster->saveX || checkFall(monster,game->map) == 1)
+        /* demi-tour au bout de la patrouille */
+        if((monster->direction == LEFT && monster->x - MONSTER_SPEED < monster->patrolMinX) ||
+           (monster->direction == RIGHT && monster->x + MONSTER_SPEED > monster->patrolMaxX))
         {
             if(monster->direction == LEFT)
             {
                 monster->direction = RIGHT;
-                changeAnimation(monster, "data/graphics/flyright.png");
+                changeAnimation(monster, CLIP_FLY_RIGHT, game);
             }
             else
             {
                 monster->direction = LEFT;
-                changeAnimation(monster, "data/graphics/flyleft.png");
+                changeAnimation(monster, CLIP_FLY_LEFT, game);
             }
         }
 
-        if(monster->direction == LEFT) monster->dirX -= 3;
-
-        else monster->dirX += 3;
+        if(monster->direction == LEFT) monster->dirX -= MONSTER_SPEED;
 
-        monster->saveX = monster->x;
+        else monster->dirX += MONSTER_SPEED;
 
         monsterCollisionToMap(monster,game->map);
+    }
+
+
+    if(monster->etat == DEAD) fallMonster(monster, game);
+}
+
+/**
+ * \fn void touchMonsters(Game* game)
+ * \brief manages the collisions between the player and the monsters around him
+ *
+ * \param[in, out] game: structure containing informations about the game
+ *
+ * To call once the monsters moved and Map.monsterBatch was sorted again: only the monsters
+ * whose x is near the player's are tested. The player loses a life, or kills the monster by jumping on it.
+ */
+void touchMonsters(Game* game){
+
+    Map* map = game->map;
+    ObjectBatch* batch = &map->monsterBatch;
+    GameObject* monster;
+    int i, last, generation = map->generation;
+
+    /* collide() ne peut toucher que les monstres dont x est entre ces bornes */
+    last = findObjectSlot(batch, game->player->x + game->player->w);
+
+    for(i = findObjectSlot(batch, game->player->x - MONSTER_WIDTH); i < last; i++){
+
+        monster = &map->monsters[batch->index[i]];
+
+        if(monster->initialized != 1 || monster->timerMort != 0) continue;
 
         if(collide(game->player,monster) == 1){
 
@@ -121,6 +173,9 @@ void updateMonsters(Game* game, GameObject* monster){
                 game->life--;
                 game->player->timerMort = 1;
                 if(game->life<1) playerGameover(game);
+
+                /* le game over a chargé le niveau une nouvelle fois : les monstres n'existent plus */
+                if(map->generation != generation) return;
             }
         }
 
@@ -129,77 +184,97 @@ void updateMonsters(Game* game, GameObject* monster){
             monster->etat = DEAD;
             monster->timerMort = 20;
             playSoundFx(DEADMINION, game);
+
+            /* il tombe dès cette frame, et l'animation de sa chute avance comme celle des autres monstres */
+            fallMonster(monster, game);
+            updateAnimation(monster, game);
         }
     }
+}
 
 
-    if(monster->etat == DEAD)
-    {
-        changeAnimation(monster, "data/graphics/flydead.png");
-
-        monster->y += 10;
-
-        monster->timerMort --;
 
-        if(monster->timerMort == 0)
-        {
-            monster->etat = ALIVE;
+/**
+ * \fn static int isWalkable(Map* map, int x, int ground)
+ * \brief tells if a monster can walk on a column
+ *
+ * \param[in] map: contains informations about the map (tiles)
+ * \param[in] x: column of the tiles
+ * \param[in] ground: row of the tile the monster walks on
+ *
+ * The column needs a solid tile on the ground row, and free tiles on the rows of the monster's body.
+ */
+static int isWalkable(Map* map, int x, int ground){
 
-            if (monster->sprite != NULL) SDL_FreeSurface(monster->sprite);
+    int y;
 
-            monster->initialized = 2;
+    if(x < 0 || x >= map->sizeX || !isSolidTile(map, x, ground)) return 0;
 
-        }
+    for(y = ground - 1; y >= ground - (MONSTER_HEIGHT + TILE_SIZE - 1)/TILE_SIZE; y--)
+    {
+        if(isSolidTile(map, x, y)) return 0;
     }
-}
-
 
+    return 1;
+}
 
 /**
- * \fn int checkFall(GameObject* monster, Map* map)
- * \brief manage the fall of a monster
+ * \fn void computePatrolExtents(GameObject* monster, Map* map)
+ * \brief computes the bounds between which a monster walks
  *
- * \param[in, out] map: contains informations about the map (tiles)
- * \param[in, out] monster: structure containing informations about the monsters
+ * \param[in, out] monster: structure containing informations about the monster, at its starting position
+ * \param[in] map: contains informations about the map (tiles)
  *
- * This function manage the fall of the monster and check if it went out of the map.
+ * Finds the ground under the monster, then walks along it on both sides until a hole or a wall.
+ * The monster turns back when it reaches patrolMinX or patrolMaxX, so the tiles
+ * don't need to be checked each frame.
  */
-int checkFall(GameObject* monster, Map* map){
-    int x,y;
+void computePatrolExtents(GameObject* monster, Map* map){
 
-    if(monster->direction == LEFT)
-    {
-        x = (int)(monster->x + monster->dirX)/TILE_SIZE;
-        y = (int)(monster->y + monster->h -1)/TILE_SIZE;
+    int ground, left, right;
 
-        if(y<0) y = 1;
+    left = monster->x / TILE_SIZE;
+    right = (monster->x + MONSTER_WIDTH - 1) / TILE_SIZE;
 
-        if(y>map->maxY) y = map->maxY;
+    /* the monster falls until the first solid tile */
+    ground = (monster->y + MONSTER_HEIGHT) / TILE_SIZE;
 
-        if(x<0) x = 1;
+    while(ground < map->sizeY && !isSolidTile(map, left, ground)) ground++;
 
-        if(x>map->maxX) x = map->maxX;
-
-        if(map->tile[y+1][x] < BLANK_TILE) return 1 ;
-
-        else return 0;
-    }
-    else
+    /* no ground: the monster falls out of the map, it doesn't walk */
+    if(ground >= map->sizeY)
     {
-        x = (int)(monster->x + monster->w + monster->dirX) / TILE_SIZE;
-        y = (int)(monster->y + monster->h - 1) / TILE_SIZE;
+        monster->patrolMinX = monster->patrolMaxX = monster->x;
+        return;
+    }
 
-        if (y <= 0) y = 1;
+    while(isWalkable(map, left - 1, ground)) left--;
 
-        if (y >= map->maxY) y = map->maxY - 1;
+    while(isWalkable(map, right + 1, ground)) right++;
 
-        if (x <= 0) x = 1;
+    monster->patrolMinX = left * TILE_SIZE;
+    monster->patrolMaxX = (right + 1) * TILE_SIZE - MONSTER_WIDTH;
 
-        if (x >= map->maxX) x = map->maxX - 1;
+    if(monster->patrolMaxX < monster->patrolMinX) monster->patrolMaxX = monster->patrolMinX;
+}
 
-        if (map->tile[y + 1][x] < BLANK_TILE) return 1;
+/**
+ * \fn void updatePatrolExtents(Game* game)
+ * \brief computes again the patrol bounds of every monster still alive
+ *
+ * \param[in, out] game: structure containing informations about the game
+ *
+ * To call when the solid tiles change.
+ */
+void updatePatrolExtents(Game* game){
 
-        else return 0;
+    int i;
+
+    for(i = 0; i < game->map->monsterNumber; i++)
+    {
+        if(game->map->monsters[i].initialized != 2)
+        {
+            computePatrolExtents(&(game->map->monsters[i]), game->map);
+        }
     }
 }
-
@@ -2,7 +2,7 @@
  * \file monster.h
  * \brief header of monster.c
  *
- *  Declaration of initializeMonster(), collide(), updateMonsters(), checkFall()
+ *  Declaration of initializeMonster(), collide(), updateMonsters(), touchMonsters(), computePatrolExtents(), updatePatrolExtents()
  *
  * \author François-Xavier Balu, Gwendal Henry, Martin Parisot, Vincent Werner
  */
@@ -13,9 +13,11 @@
 #include "game.h"
 
 
-void initializeMonster(GameObject* monster, int x, int y);
+void initializeMonster(GameObject* monster, int x, int y, Game* game);
 int collide(GameObject* player,GameObject* monster);
 void updateMonsters(Game* game, GameObject* monster);
-int checkFall(GameObject* monster, Map* map);
+void touchMonsters(Game* game);
+void computePatrolExtents(GameObject* monster, Map* map);
+void updatePatrolExtents(Game* game);
 
 #endif // MONSTER_H_INCLUDED
@@ -4,8 +4,34 @@
 #include "player.h"
 #include "sound.h"
 #include "animation.h"
-
-void drawObjectTile(GameObject object, int k, Game* game){
+#include "objectbatch.h"
+#include "trigger.h"
+#include "arena.h"
+
+/* l'objet n'est pas dessiné */
+#define NO_TILE -100
+
+/* tile dessinée pour chaque type d'objet immobile selon son état (initialized à 0 ou 1) :
+   décalage par rapport à son gid, ou NO_TILE quand il est caché */
+static const int objectTiles[OBJECT_TYPES][2] = {
+
+    { NO_TILE, NO_TILE },   /* type inconnu */
+    { -1, NO_TILE },        /* COIN */
+    { -1, NO_TILE },        /* DOOR */
+    { -1, 0 },              /* BLUE_SWITCH */
+    { -1, 0 },              /* GREEN_SWITCH */
+    { -1, 0 },              /* YELLOW_SWITCH */
+    { -1, 0 },              /* RED_SWITCH */
+    { -1, NO_TILE },        /* BLUE_BLOCK */
+    { -1, NO_TILE },        /* GREEN_BLOCK */
+    { -1, NO_TILE },        /* YELLOW_BLOCK */
+    { NO_TILE, -1 },        /* RED_BLOCK */
+    { -1, NO_TILE },        /* PICK */
+    { NO_TILE, -1 },        /* ELEVATOR_BLOCK */
+    { -1, -3 }              /* ELEVATOR_SWITCH */
+};
+
+void drawObjectTile(int gid, int x, int y, int k, Game* game){
 
 
     int ysource, xsource;
@@ -13,459 +39,452 @@ void drawObjectTile(GameObject object, int k, Game* game){
     /* Calcul pour obtenir son y (pour un tileset de 10 tiles
     par ligne, d'où le 10 */
 
-    ysource = (object.gid + k) / 10 * TILE_SIZE;
+    ysource = (gid + k) / 10 * TILE_SIZE;
 
     /* Et son x */
 
-    xsource = (object.gid + k) % 10 * TILE_SIZE;
+    xsource = (gid + k) % 10 * TILE_SIZE;
 
     /* Fonction qui blitte la bonne tile au bon endroit en tenant compte du scrolling*/
 
-    drawTile(game->map->tileSet, object.x - game->map->startX, object.y - game->map->startY, xsource, ysource, game);
+    drawTile(game->map->tileSet, x - game->map->startX, y - game->map->startY, xsource, ysource, game);
 
 }
 
 void drawObject(Game* game){
 
-    int i;
-
-    for(i=0; i<game->objectNumber; i++){
-
-        switch(game->map->objects[i].type){
-
-            case COIN :
-
-                if(game->map->objects[i].initialized == 0) drawObjectTile( game->map->objects[i], -1, game );
-
-
-                break;
-
-
-            case DOOR :
-
-
-                if(game->map->objects[i].initialized == 0) drawObjectTile( game->map->objects[i], -1, game );
-
-
-
-                break;
+    Map* map = game->map;
+    ObjectBatch* batch;
+    GameObject* monster;
+    int i, t, k, last, minX, maxX;
 
+    /* seulement les objets devant la caméra : un objet qui commence avant le bord gauche peut encore dépasser sur l'écran */
+    minX = map->startX - 2 * TILE_SIZE;
+    maxX = map->startX + SCREEN_WIDTH;
 
-            case GREEN_BLOCK :
+    for(t=1; t<OBJECT_TYPES; t++){
 
-                if(game->map->objects[i].initialized == 0) drawObjectTile( game->map->objects[i], -1, game );
+        batch = &map->batches[t];
+        last = findObjectSlot(batch, maxX + 1);
 
+        for(i=findObjectSlot(batch, minX); i<last; i++){
 
-                break;
+            k = objectTiles[t][batch->initialized[i]];
 
-            case RED_BLOCK :
-
-                if(game->map->objects[i].initialized == 1) drawObjectTile( game->map->objects[i], -1, game );
-
-                break;
-
-            case YELLOW_BLOCK :
-
-                if(game->map->objects[i].initialized == 0) drawObjectTile( game->map->objects[i], -1, game );
-
-                break;
+            if(k != NO_TILE) drawObjectTile(batch->gid[i], batch->x[i], batch->y[i], k, game);
+        }
+    }
 
-            case BLUE_BLOCK :
+    /* les monstres par-dessus, par x croissant ; leur animation avance dans updateObject() */
+    batch = &map->monsterBatch;
+    last = findObjectSlot(batch, maxX + 1);
 
-                if(game->map->objects[i].initialized == 0) drawObjectTile( game->map->objects[i], -1, game );
+    for(i=findObjectSlot(batch, minX); i<last; i++){
 
-                break;
+        monster = &map->monsters[batch->index[i]];
 
-            case GREEN_SWITCH :
+        if(monster->initialized == 1) drawAnimationFrame(monster, game);
+    }
+}
 
-                if(game->map->objects[i].initialized == 0) drawObjectTile( game->map->objects[i], -1, game );
+int collideObject(GameObject* player, int x, int y){
 
-                if(game->map->objects[i].initialized == 1) drawObjectTile( game->map->objects[i], 0, game );
 
-                break;
+    if( (player->x >= x + TILE_SIZE)  ||
+        (player->x + player->w <= x)   ||
+        (player->y >= TILE_SIZE + y)  ||
+        (player->y + player->h <= y))
 
-            case RED_SWITCH :
+    return 0;
 
-                if(game->map->objects[i].initialized == 0) drawObjectTile( game->map->objects[i], -1, game );
 
-                if(game->map->objects[i].initialized == 1) drawObjectTile( game->map->objects[i], 0, game );
+    else return 1;
+}
 
-                break;
+int collidePick(GameObject* player, int x, int y){
 
-            case YELLOW_SWITCH :
 
-                if(game->map->objects[i].initialized == 0) drawObjectTile( game->map->objects[i], -1, game );
+    if( (player->x >= x + TILE_SIZE - 20)  ||
+        (player->x + player->w <= x + 20)   ||
+        (player->y >= TILE_SIZE + y - 40)  ||
+        (player->y + player->h <= y + 40))
 
-                if(game->map->objects[i].initialized == 1) drawObjectTile( game->map->objects[i], 0, game );
+    return 0;
 
-                break;
 
-            case BLUE_SWITCH :
+    else return 1;
+}
 
-                if(game->map->objects[i].initialized == 0) drawObjectTile( game->map->objects[i], -1, game );
+static void touchCoin(Game* game, ObjectBatch* batch, int i){
 
-                if(game->map->objects[i].initialized == 1) drawObjectTile( game->map->objects[i], 0, game );
+    if(batch->initialized[i] == 0 && collideObject(game->player, batch->x[i], batch->y[i]) == 1){
+        getItem(game);
+        batch->initialized[i] = 1;
+    }
+}
 
-                break;
+static void touchPick(Game* game, ObjectBatch* batch, int i){
 
+    if(batch->initialized[i] == 0 && collidePick(game->player, batch->x[i], batch->y[i]) == 1 && game->life > 0){
 
+        game->life--;
+        game->player->timerMort = 1;
+        if(game->life<1) playerGameover(game);
+    }
+}
 
-            case PICK :
+static void useSwitch(Game* game, ObjectBatch* batch, int i){
 
-                if(game->map->objects[i].initialized == 0) drawObjectTile( game->map->objects[i], -1, game );
+    if(collideObject(game->player, batch->x[i], batch->y[i]) == 1){
 
-                break;
+        if(batch->initialized[i] == 0) activateSwitch(batch->group[i], game);
 
-            case ELEVATOR_BLOCK:
+        else desactivateSwitch(batch->group[i], game);
 
-                if(game->map->objects[i].initialized == 1) drawObjectTile( game->map->objects[i], -1, game );
+        batch->initialized[i] = !batch->initialized[i];
+        game->input->use = 0;
+        playSoundFx(SWITCHSOUND,game);
+    }
+}
 
-                break;
+static void touchDoor(Game* game, ObjectBatch* batch, int i){
 
-            case ELEVATOR_SWITCH:
+    if(batch->initialized[i] == 0 && collideObject(game->player, batch->x[i], batch->y[i]) == 1){
 
-                if(game->map->objects[i].initialized == 0) drawObjectTile( game->map->objects[i], -1, game );
+        game->level++;
 
-                if(game->map->objects[i].initialized == 1) drawObjectTile( game->map->objects[i], -3, game );
+        endLevel(game);
+    }
+}
 
-                break;
+/* événements de chaque type d'objet immobile : entrer, rester, sortir, use ;
+   les blocs n'en ont pas, ils sont dans la solidité des tiles (placeSolidBlocks) */
+static const TriggerType objectTriggers[OBJECT_TYPES] = {
+
+    { NULL, NULL, NULL, NULL },                             /* type inconnu */
+    { touchCoin, touchCoin, NULL, NULL },                   /* COIN */
+    { touchDoor, touchDoor, NULL, NULL },                   /* DOOR */
+    { NULL, NULL, NULL, useSwitch },                        /* BLUE_SWITCH */
+    { NULL, NULL, NULL, useSwitch },                        /* GREEN_SWITCH */
+    { NULL, NULL, NULL, useSwitch },                        /* YELLOW_SWITCH */
+    { NULL, NULL, NULL, useSwitch },                        /* RED_SWITCH */
+    { NULL, NULL, NULL, NULL },                             /* BLUE_BLOCK */
+    { NULL, NULL, NULL, NULL },                             /* GREEN_BLOCK */
+    { NULL, NULL, NULL, NULL },                             /* YELLOW_BLOCK */
+    { NULL, NULL, NULL, NULL },                             /* RED_BLOCK */
+    { touchPick, touchPick, NULL, NULL },                   /* PICK */
+    { NULL, NULL, NULL, NULL },                             /* ELEVATOR_BLOCK */
+    { NULL, NULL, NULL, useSwitch }                         /* ELEVATOR_SWITCH */
+};
+
+/* ordre d'évaluation : les portes en dernier */
+static const int objectTriggerOrder[] = {
+
+    COIN, PICK,
+    BLUE_SWITCH, GREEN_SWITCH, YELLOW_SWITCH, RED_SWITCH, ELEVATOR_SWITCH,
+    DOOR
+};
+
+/* Les volumes de déclenchement des objets immobiles, une fois les batches du niveau remplies */
+void buildObjectTriggers(Map* map){
+
+    map->triggers = createTriggerTable(map, objectTriggers, objectTriggerOrder,
+                                       sizeof(objectTriggerOrder) / sizeof(objectTriggerOrder[0]));
+}
 
-            case FLY :
+void updateObject(Game* game){
 
-                if(game->map->objects[i].initialized == 1) drawAnimatedEntity(&(game->map->objects[i]),game);
+    Map* map = game->map;
+    GameObject* monster;
+    int i, generation = map->generation;
 
-                break;
+    /* les monstres bougent même loin du joueur */
+    for(i=0; i<map->monsterNumber; i++){
 
+        monster = &map->monsters[i];
 
-            default :
+        if(monster->initialized == 0) initializeMonster(monster, monster->x, monster->y, game);
 
-                break;
+        if(monster->initialized == 1) updateMonsters(game, monster);
 
-        }
+        /* aussi hors de l'écran, pour qu'un monstre qui y revient soit à la même image */
+        if(monster->initialized == 1) updateAnimation(monster, game);
     }
-}
 
-int collideObject(GameObject* player,GameObject* object){
+    /* touchMonsters() et drawObject() cherchent dans monsterBatch les monstres autour du joueur et devant la caméra */
+    sortMonsterBatch(map);
 
+    touchMonsters(game);
 
-    if( (player->x >= object->x + TILE_SIZE)  ||
-        (player->x + player->w <= object->x)   ||
-        (player->y >= TILE_SIZE + object->y)  ||
-        (player->y + player->h <= object->y))
-
-    return 0;
+    /* un game over a chargé le niveau une nouvelle fois */
+    if(map->generation != generation) return;
 
+    /* les autres objets seulement quand le joueur est dans leurs tiles */
+    updateTriggers(game);
+}
 
-    else return 1;
+void getItem(Game* game){
+    game->coin++;
+    playSoundFx(COINSOUND,game);
 }
 
-int collidePick(GameObject* player,GameObject* object){
+/* couleur des blocs commandés par un interrupteur ; un bloc est dans les groupes de sa propre couleur */
+static int getBlockColor(int type){
 
+    switch(type){
 
-    if( (player->x >= object->x + TILE_SIZE - 20)  ||
-        (player->x + player->w <= object->x + 20)   ||
-        (player->y >= TILE_SIZE + object->y - 40)  ||
-        (player->y + player->h <= object->y + 40))
+        case BLUE_SWITCH : return BLUE_BLOCK;
+        case GREEN_SWITCH : return GREEN_BLOCK;
+        case YELLOW_SWITCH : return YELLOW_BLOCK;
+        case RED_SWITCH : return RED_BLOCK;
+        case ELEVATOR_SWITCH : return ELEVATOR_BLOCK;
 
-    return 0;
+        case BLUE_BLOCK :
+        case GREEN_BLOCK :
+        case YELLOW_BLOCK :
+        case RED_BLOCK :
+        case ELEVATOR_BLOCK : return type;
 
-
-    else return 1;
+        default : return 0;
+    }
 }
 
-void updateObject(Game* game){
-
-    int i;
-
-    for(i=0; i<game->objectNumber; i++){
+/* Range les blocs par groupe, une fois les batches du niveau remplies.
+   Un groupe réunit les blocs d'une couleur qui ont le même numéro (propriété "group" du TMX, 0 par défaut) :
+   les interrupteurs de cette couleur et de ce numéro ne commandent que ces blocs.
+   En entrée, group contient le numéro lu dans le TMX ; en sortie, l'indice du groupe dans map->groupStart, -1 pour les autres objets. */
+void buildSwitchGroups(Map* map){
 
-        switch (game->map->objects[i].type){
+    ObjectBatch* batch;
+    int i, t, g, color, groupMax = 0, blockNumber = 0;
+    int *groupValue, *position;
 
+    map->groupNumber = 0;
 
-            case FLY :
-
-            if(game->map->objects[i].initialized == 0) initializeMonster(&(game->map->objects[i]),game->map->objects[i].x,game->map->objects[i].y);
+    for(t=0; t<OBJECT_TYPES; t++){
+        if(getBlockColor(t) != 0) groupMax += map->batches[t].number;
+        if(getBlockColor(t) == t) blockNumber += map->batches[t].number;
+    }
 
-            if(game->map->objects[i].initialized == 1) updateMonsters(game, &(game->map->objects[i]));
+    map->groupColor = (int*)arenaAlloc(map->arena, (groupMax + 1) * sizeof(int));
+    groupValue = (int*)arenaAlloc(map->arena, (groupMax + 1) * sizeof(int));
+    position = (int*)arenaAlloc(map->arena, (groupMax + 2) * sizeof(int));
 
-            break;
+    if(map->groupColor == NULL || groupValue == NULL || position == NULL){
+        printf("Couldn't allocate the groups of %d blocks\n", blockNumber);
+        exit(1);
+    }
 
-            case COIN :
+    /* un groupe pour chaque couple (couleur, numéro), les niveaux n'en ont que quelques-uns */
+    for(t=0; t<OBJECT_TYPES; t++){
 
-                if((collideObject(game->player,&(game->map->objects[i])) == 1) && (game->map->objects[i].initialized == 0))
-                {
-                    getItem(game);
-                    game->map->objects[i].initialized =1 ;
-                }
+        batch = &map->batches[t];
+        color = getBlockColor(t);
 
-                break;
+        for(i=0; i<batch->number; i++){
 
-            case DOOR :
+            if(color == 0){
+                batch->group[i] = -1;
+                continue;
+            }
 
-                if((collideObject(game->player,&(game->map->objects[i])) == 1) && (game->map->objects[i].initialized == 0)){
+            for(g=0; g<map->groupNumber; g++){
+                if(map->groupColor[g] == color && groupValue[g] == batch->group[i]) break;
+            }
 
-                    game->level++;
+            if(g == map->groupNumber){
+                map->groupColor[g] = color;
+                groupValue[g] = batch->group[i];
+                map->groupNumber++;
+            }
 
-                    endLevel(game);
-                }
+            batch->group[i] = g;
+        }
+    }
 
-                break;
+    map->groupStart = (int*)arenaAlloc(map->arena, (map->groupNumber + 1) * sizeof(int));
+    map->groupBlocks = (int*)arenaAlloc(map->arena, (blockNumber + 1) * sizeof(int));
 
-            case BLUE_BLOCK :
+    if(map->groupStart == NULL || map->groupBlocks == NULL){
+        printf("Couldn't allocate the groups of %d blocks\n", blockNumber);
+        exit(1);
+    }
 
-                if((collideObject(game->player,&(game->map->objects[i])) == 1) && (game->map->objects[i].initialized == 0)){
-                    isSolid(game->player,&(game->map->objects[i]));
-                }
+    /* les places des blocs d'un groupe se suivent dans groupBlocks */
+    for(g=0; g<=map->groupNumber; g++) position[g] = 0;
 
-                break;
+    for(t=0; t<OBJECT_TYPES; t++){
+        if(getBlockColor(t) != t) continue;
 
-            case GREEN_BLOCK :
+        for(i=0; i<map->batches[t].number; i++) position[map->batches[t].group[i] + 1]++;
+    }
 
-                if((collideObject(game->player,&(game->map->objects[i])) == 1) && (game->map->objects[i].initialized == 0)){
-                    isSolid(game->player,&(game->map->objects[i]));
-                }
+    for(g=0; g<map->groupNumber; g++) position[g + 1] += position[g];
 
-                break;
+    for(g=0; g<=map->groupNumber; g++) map->groupStart[g] = position[g];
 
-            case YELLOW_BLOCK :
+    for(t=0; t<OBJECT_TYPES; t++){
+        if(getBlockColor(t) != t) continue;
 
+        for(i=0; i<map->batches[t].number; i++) map->groupBlocks[position[map->batches[t].group[i]]++] = i;
+    }
+}
 
-                if((collideObject(game->player,&(game->map->objects[i])) == 1) && (game->map->objects[i].initialized == 0)){
-                    isSolid(game->player,&(game->map->objects[i]));
-                }
+/* un bloc est solide quand il n'est pas activé, sauf les rouges et les ascenseurs qui le deviennent une fois activés */
+static int isBlockSolid(int type, int state){
 
-                break;
+    if(type == RED_BLOCK || type == ELEVATOR_BLOCK) return state == 1;
 
-            case RED_BLOCK :
+    return state == 0;
+}
 
-                if((collideObject(game->player,&(game->map->objects[i])) == 1) && (game->map->objects[i].initialized == 1)){
-                    isSolid(game->player,&(game->map->objects[i]));
-                }
+/* place de la tile (y * sizeX + x) dans map->blockTiles, -1 si aucun bloc n'est dessus */
+static int findBlockTile(Map* map, int tile){
 
-                break;
+    int first = 0, last = map->blockTileNumber - 1, middle;
 
+    while(first <= last){
 
-            case PICK :
+        middle = (first + last) / 2;
 
-                if((collidePick(game->player,&(game->map->objects[i])) == 1) && (game->map->objects[i].initialized == 0)){
-                    if(game->life > 0)
-                    {
-                        game->life--;
-                        game->player->timerMort = 1;
-                        if(game->life<1) playerGameover(game);
-                    }
-                }
+        if(map->blockTiles[middle] == tile) return middle;
 
-                break;
+        if(map->blockTiles[middle] < tile) first = middle + 1;
 
-            case ELEVATOR_BLOCK :
+        else last = middle - 1;
+    }
 
+    return -1;
+}
 
-                if((collideObject(game->player,&(game->map->objects[i])) == 1) && (game->map->objects[i].initialized == 1)){
-                    isSolid(game->player,&(game->map->objects[i]));
-                }
+/* tile d'un bloc, -1 hors de la map ; cookLevel() refuse les blocs qui ne sont pas sur la grille */
+static int getBlockTile(Map* map, ObjectBatch* batch, int i){
 
-                break;
+    int x = batch->x[i] / TILE_SIZE, y = batch->y[i] / TILE_SIZE;
 
-            case ELEVATOR_SWITCH :
+    if(batch->x[i] < 0 || batch->y[i] < 0 || x >= map->sizeX || y >= map->sizeY) return -1;
 
+    return y * map->sizeX + x;
+}
 
-                if((collideObject(game->player,&(game->map->objects[i])) == 1) && (game->map->objects[i].initialized == 0) && (game->input->use == 1)){
-                    activateSwitch(ELEVATOR_BLOCK,game);
-                    game->map->objects[i].initialized = 1;
-                    game->input->use =0;
-                    playSoundFx(SWITCHSOUND,game);
-                    break;
-                }
+/* ajoute (change à 1) ou retire (-1) un bloc du nombre de blocs solides posés sur sa tile */
+static void changeBlockSolidity(Map* map, ObjectBatch* batch, int i, int change){
 
-                if((collideObject(game->player,&(game->map->objects[i])) == 1) && (game->map->objects[i].initialized == 1) && (game->input->use == 1)){
-                    desactivateSwitch(ELEVATOR_BLOCK,game);
-                    game->map->objects[i].initialized = 0;
-                    game->input->use = 0;
-                    playSoundFx(SWITCHSOUND,game);
-                    break;
-                }
+    int tile = getBlockTile(map, batch, i);
 
-                break;
+    if(tile >= 0) map->blockSolid[findBlockTile(map, tile)] += change;
+}
 
-            case BLUE_SWITCH :
+static int compareTiles(const void* a, const void* b){
 
-                if((collideObject(game->player,&(game->map->objects[i])) == 1) && (game->map->objects[i].initialized == 0) && (game->input->use == 1)){
-                    activateSwitch(BLUE_BLOCK,game);
-                    game->map->objects[i].initialized = 1;
-                    game->input->use =0;
-                    playSoundFx(SWITCHSOUND,game);
-                    break;
-                }
+    return *(const int*)a - *(const int*)b;
+}
 
-                if((collideObject(game->player,&(game->map->objects[i])) == 1) && (game->map->objects[i].initialized == 1) && (game->input->use == 1)){
-                    desactivateSwitch(BLUE_BLOCK,game);
-                    game->map->objects[i].initialized = 0;
-                    game->input->use = 0;
-                    playSoundFx(SWITCHSOUND,game);
-                    break;
-                }
+/* Range les tiles sous les blocs, puis pose sur elles les blocs solides au début du niveau ;
+   la mémoire dépend du nombre de blocs, pas de la taille du niveau */
+void placeSolidBlocks(Map* map){
 
-                break;
+    ObjectBatch* batch;
+    int i, t, tile, blockNumber = 0;
 
-            case GREEN_SWITCH :
+    for(t=0; t<OBJECT_TYPES; t++){
+        if(getBlockColor(t) == t) blockNumber += map->batches[t].number;
+    }
 
-                if((collideObject(game->player,&(game->map->objects[i])) == 1) && (game->map->objects[i].initialized == 0) && (game->input->use == 1)){
-                    activateSwitch(GREEN_BLOCK,game);
-                    game->map->objects[i].initialized = 1;
-                    game->input->use =0;
-                    playSoundFx(SWITCHSOUND,game);
-                    break;
-                }
+    map->blockTiles = (int*)arenaAlloc(map->arena, (blockNumber + 1) * sizeof(int));
+    map->blockSolid = (unsigned char*)arenaAlloc(map->arena, blockNumber + 1);
+    map->blockTileNumber = 0;
 
-                if((collideObject(game->player,&(game->map->objects[i])) == 1) && (game->map->objects[i].initialized == 1) && (game->input->use == 1)){
-                    desactivateSwitch(GREEN_BLOCK,game);
-                    game->map->objects[i].initialized = 0;
-                    game->input->use = 0;
-                    playSoundFx(SWITCHSOUND,game);
-                    break;
-                }
+    if(map->blockTiles == NULL || map->blockSolid == NULL){
+        printf("Couldn't allocate the tiles of %d blocks\n", blockNumber);
+        exit(1);
+    }
 
-                break;
+    for(t=0; t<OBJECT_TYPES; t++){
 
-            case YELLOW_SWITCH :
+        if(getBlockColor(t) != t) continue;
 
-                 if((collideObject(game->player,&(game->map->objects[i])) == 1) && (game->map->objects[i].initialized == 0) && (game->input->use == 1)){
-                    activateSwitch(YELLOW_BLOCK,game);
-                    game->map->objects[i].initialized = 1;
-                    game->input->use =0;
-                    playSoundFx(SWITCHSOUND,game);
-                    break;
-                }
+        batch = &map->batches[t];
 
-                if((collideObject(game->player,&(game->map->objects[i])) == 1) && (game->map->objects[i].initialized == 1) && (game->input->use == 1)){
-                    desactivateSwitch(YELLOW_BLOCK,game);
-                    game->map->objects[i].initialized = 0;
-                    game->input->use = 0;
-                    playSoundFx(SWITCHSOUND,game);
-                    break;
-                }
-
-                break;
-
-            case RED_SWITCH :
-
-                 if((collideObject(game->player,&(game->map->objects[i])) == 1) && (game->map->objects[i].initialized == 0) && (game->input->use == 1)){
-                    activateSwitch(RED_BLOCK,game);
-                    game->map->objects[i].initialized = 1;
-                    game->input->use =0;
-                    playSoundFx(SWITCHSOUND,game);
-                    break;
-                }
-
-                if((collideObject(game->player,&(game->map->objects[i])) == 1) && (game->map->objects[i].initialized == 1) && (game->input->use == 1)){
-                    desactivateSwitch(RED_BLOCK,game);
-                    game->map->objects[i].initialized = 0;
-                    game->input->use = 0;
-                    playSoundFx(SWITCHSOUND,game);
-                    break;
-                }
-
-                break;
-
-            default :
-
-                break;
+        for(i=0; i<batch->number; i++){
+            if((tile = getBlockTile(map, batch, i)) >= 0) map->blockTiles[map->blockTileNumber++] = tile;
         }
     }
-}
 
-void isSolid(GameObject *entity, GameObject *object){
-
-    if(object->spe == 1){
+    qsort(map->blockTiles, map->blockTileNumber, sizeof(int), compareTiles);
 
+    /* plusieurs blocs sur la même tile n'y prennent qu'une place */
+    for(i=0, tile=0; i<map->blockTileNumber; i++){
+        if(tile == 0 || map->blockTiles[i] != map->blockTiles[tile - 1]) map->blockTiles[tile++] = map->blockTiles[i];
+    }
 
+    map->blockTileNumber = tile;
+    memset(map->blockSolid, 0, map->blockTileNumber + 1);
 
-            if (entity->dirY > 0)
-            {
-               entity->dirY = 0;
+    for(t=0; t<OBJECT_TYPES; t++){
 
-               entity->y = object->y - entity->h;
+        if(getBlockColor(t) != t) continue;
 
-                entity->onGround = 1;
+        batch = &map->batches[t];
 
-            }
+        for(i=0; i<batch->number; i++){
+            if(isBlockSolid(t, batch->initialized[i])) changeBlockSolidity(map, batch, i, 1);
         }
+    }
+}
 
-    if(object->spe == 2){
+/* 1 si un bloc solide est posé sur la tile (x, y) */
+int hasSolidBlock(Map* map, int x, int y){
 
+    int i = findBlockTile(map, y * map->sizeX + x);
 
+    return i >= 0 && map->blockSolid[i] != 0;
+}
 
-            if (entity->dirX > 0)
-            {
+/* met les blocs du groupe dans l'état state ; seules leurs tiles changent */
+static void setGroupState(int group, int state, Game* game){
 
-                    entity->dirX=0;
-                    entity->x = object->x - entity->w ;
+    Map* map = game->map;
+    ObjectBatch* batch;
+    int i, slot, color, changed = 0;
 
-            }
+    if(group < 0) return;
 
+    color = map->groupColor[group];
+    batch = &map->batches[color];
 
+    for(i=map->groupStart[group]; i<map->groupStart[group + 1]; i++){
 
-            else if (entity->dirX < 0)
-            {
+        slot = map->groupBlocks[i];
 
-                    entity->dirX=0;
-                    entity->x =  object->x + entity->w ;
+        if(batch->initialized[slot] == state) continue;
 
+        if(isBlockSolid(color, batch->initialized[slot])) changeBlockSolidity(map, batch, slot, -1);
 
-            }
+        batch->initialized[slot] = state;
 
+        if(isBlockSolid(color, state)) changeBlockSolidity(map, batch, slot, 1);
 
+        changed = 1;
     }
 
-
-
-}
-
-void getItem(Game* game){
-    game->coin++;
-    playSoundFx(COINSOUND,game);
+    /* les monstres marchent jusqu'aux nouveaux blocs, ou au-delà de ceux qui ont disparu */
+    if(changed) updatePatrolExtents(game);
 }
 
-void activateSwitch(int colorBlock, Game* game){
-
-    int i;
-
-    for(i=0;i<game->objectNumber;i++)
-
-    if(game->map->objects[i].type == colorBlock){
-
-        game->map->objects[i].initialized = 1;
-
-
-    }
+void activateSwitch(int group, Game* game){
 
+    setGroupState(group, 1, game);
 }
 
-void desactivateSwitch(int colorBlock, Game* game){
-
-
-    int i;
-
-    for(i=0;i<game->objectNumber;i++)
-
-    if(game->map->objects[i].type == colorBlock){
-
-        game->map->objects[i].initialized = 0;
-
-
-    }
-
+void desactivateSwitch(int group, Game* game){
 
+    setGroupState(group, 0, game);
 }
 
 void destroyGameObject(GameObject* object){
 
     if(object != NULL){
-
-        if(object->sprite != NULL) SDL_FreeSurface(object->sprite);
         free(object);
     }
 }
-
-
@@ -6,14 +6,17 @@
 
 
 
-void drawObjectTile(GameObject object, int k, Game* game);
+void drawObjectTile(int gid, int x, int y, int k, Game* game);
 void drawObject(Game* game);
-int collideObject(GameObject* player,GameObject* object);
-int collidePick(GameObject* player,GameObject* object);
+int collideObject(GameObject* player, int x, int y);
+int collidePick(GameObject* player, int x, int y);
 void updateObject(Game* game);
-void isSolid(GameObject *entity, GameObject *object);
-void activateSwitch(int colorBlock, Game* game);
-void desactivateSwitch(int colorBlock, Game* game);
+void buildSwitchGroups(Map* map);
+void buildObjectTriggers(Map* map);
+void placeSolidBlocks(Map* map);
+int hasSolidBlock(Map* map, int x, int y);
+void activateSwitch(int group, Game* game);
+void desactivateSwitch(int group, Game* game);
 void getItem(Game* game);
 void destroyGameObject(GameObject* object);
 
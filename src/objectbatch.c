@@ -0,0 +1,213 @@
+/**
+ * \file objectbatch.c
+ * \brief contains the storage of the objects of the level
+ *
+ * Implementation of fillObjectBatches, sortMonsterBatch and findObjectSlot.
+ *
+ * The objects which don't move (coins, doors, switches, blocks, spikes) are stored by type,
+ * one ObjectBatch for each type, with a table for each field instead of a table of structures:
+ * drawObject() and updateObject() go through each type in a loop without switch, and only read
+ * the fields they need. The objects of a batch are sorted by x, so the ones in front of the camera
+ * or around the player are found by a binary search with findObjectSlot().
+ *
+ * The monsters move and are animated like the player: they stay GameObject structures, in Map.monsters.
+ * Map.monsterBatch keeps their x sorted, with their place in Map.monsters: it is sorted again by
+ * sortMonsterBatch() each time they move, and searched with findObjectSlot() like the other batches.
+ *
+ * \author François-Xavier Balu, Gwendal Henry, Martin Parisot, Vincent Werner
+ */
+
+#include "objectbatch.h"
+#include "arena.h"
+
+/* tables de chaque batch : x, y, initialized, gid, spe, group et index */
+#define BATCH_FIELDS 7
+
+/* la place d'un objet dans le TMX est rangée dans les 28 bits bas de la clé de tri */
+#define BATCH_INDEX_BITS 28
+
+
+/**
+ * \fn static int getBatchType(int type)
+ * \brief Give the batch of an object which isn't a monster, 0 for an unknown type
+ */
+static int getBatchType(int type) {
+
+   return (type > 0 && type < OBJECT_TYPES) ? type : 0;
+}
+
+/**
+ * \fn static int compareKey(const void* a, const void* b)
+ * \brief Order of the sort keys for qsort()
+ */
+static int compareKey(const void* a, const void* b) {
+
+   unsigned long long keyA = *(const unsigned long long*)a, keyB = *(const unsigned long long*)b;
+
+   return keyA < keyB ? -1 : keyA > keyB;
+}
+
+/**
+ * \fn void fillObjectBatches(Map* map, GameObject* objects, int* groups, int objectNumber)
+ * \brief Store the objects read in the TMX file in the batches of the map, and its monsters
+ *
+ * \param[in, out] map: the map, the batches are allocated in its arena
+ * \param[in] objects: the objects in the order of the TMX file, with their type, spe, gid, x, y and initialized
+ * \param[in] groups: the group number of each object read in the TMX file, see buildSwitchGroups()
+ * \param[in] objectNumber: number of objects, less than 2^28
+ *
+ * The objects of a batch are sorted by x, then by their place in the TMX file.
+ * The monsters stay in the order of the TMX file, Map.monsterBatch gives them by x.
+ */
+void fillObjectBatches(Map* map, GameObject* objects, int* groups, int objectNumber) {
+
+   unsigned long long *keys;
+   int i, k, t, slot, keyNumber = 0, count[OBJECT_TYPES];
+   int *data;
+   ObjectBatch* batch;
+
+   map->generation++;
+   map->monsterNumber = 0;
+
+   map->objectType = (int*)arenaAlloc(map->arena, (objectNumber + 1) * sizeof(int));
+   map->objectSlot = (int*)arenaAlloc(map->arena, (objectNumber + 1) * sizeof(int));
+   map->monsters = (GameObject*)arenaAlloc(map->arena, (objectNumber + 1) * sizeof(GameObject));
+   keys = (unsigned long long*)arenaAlloc(map->arena, (objectNumber + 1) * sizeof(unsigned long long));
+
+   if(map->objectType == NULL || map->objectSlot == NULL || map->monsters == NULL || keys == NULL) {
+      printf("Couldn't allocate the batches of %d objects\n", objectNumber);
+      exit(1);
+   }
+
+   for(t = 0; t < OBJECT_TYPES; t++) count[t] = 0;
+
+   for(i = 0; i < objectNumber; i++) {
+
+      if(objects[i].type == FLY) {
+         map->objectType[i] = FLY;
+         map->objectSlot[i] = map->monsterNumber;
+         map->monsters[map->monsterNumber++] = objects[i];
+
+         continue;
+      }
+
+      t = getBatchType(objects[i].type);
+      count[t]++;
+
+      /* tri par type, puis par x (le bit de signe inversé garde l'ordre des x négatifs), puis par place dans le TMX */
+      keys[keyNumber++] = ((unsigned long long)t << (32 + BATCH_INDEX_BITS)) |
+                          ((unsigned long long)((unsigned int)objects[i].x ^ 0x80000000u) << BATCH_INDEX_BITS) |
+                          (unsigned long long)i;
+   }
+
+   /* une seule allocation par batch, découpée en tables */
+   for(t = 0; t < OBJECT_TYPES; t++) {
+
+      if((data = (int*)arenaAlloc(map->arena, (BATCH_FIELDS * count[t] + 1) * sizeof(int))) == NULL) {
+         printf("Couldn't allocate the batches of %d objects\n", objectNumber);
+         exit(1);
+      }
+
+      batch = &map->batches[t];
+
+      batch->number = 0;
+      batch->x = data;
+      batch->y = data + count[t];
+      batch->initialized = data + 2 * count[t];
+      batch->gid = data + 3 * count[t];
+      batch->spe = data + 4 * count[t];
+      batch->group = data + 5 * count[t];
+      batch->index = data + 6 * count[t];
+   }
+
+   qsort(keys, keyNumber, sizeof(unsigned long long), compareKey);
+
+   for(k = 0; k < keyNumber; k++) {
+
+      i = (int)(keys[k] & ((1ULL << BATCH_INDEX_BITS) - 1));
+      t = getBatchType(objects[i].type);
+
+      batch = &map->batches[t];
+      slot = batch->number++;
+
+      batch->x[slot] = objects[i].x;
+      batch->y[slot] = objects[i].y;
+      batch->initialized[slot] = objects[i].initialized;
+      batch->gid[slot] = objects[i].gid;
+      batch->spe[slot] = objects[i].spe;
+      batch->group[slot] = groups[i];
+      batch->index[slot] = i;
+
+      map->objectType[i] = t;
+      map->objectSlot[i] = slot;
+   }
+
+   if((data = (int*)arenaAlloc(map->arena, (2 * map->monsterNumber + 1) * sizeof(int))) == NULL) {
+      printf("Couldn't allocate the batches of %d objects\n", objectNumber);
+      exit(1);
+   }
+
+   batch = &map->monsterBatch;
+
+   batch->number = map->monsterNumber;
+   batch->x = data;
+   batch->index = data + map->monsterNumber;
+   batch->y = batch->initialized = batch->gid = batch->spe = batch->group = NULL;
+
+   for(i = 0; i < map->monsterNumber; i++) batch->index[i] = i;
+
+   sortMonsterBatch(map);
+}
+
+/**
+ * \fn void sortMonsterBatch(Map* map)
+ * \brief Sort Map.monsterBatch again after the monsters moved
+ *
+ * \param[in, out] map: the map and its monsters
+ *
+ * The monsters are sorted by x, then by their place in Map.monsters.
+ * They move by a few pixels in a frame, so the batch is nearly sorted and an insertion sort goes through it about once.
+ */
+void sortMonsterBatch(Map* map) {
+
+   ObjectBatch* batch = &map->monsterBatch;
+   int i, j, x, index;
+
+   for(i = 0; i < batch->number; i++) batch->x[i] = map->monsters[batch->index[i]].x;
+
+   for(i = 1; i < batch->number; i++) {
+
+      x = batch->x[i];
+      index = batch->index[i];
+
+      for(j = i; j > 0 && (batch->x[j - 1] > x || (batch->x[j - 1] == x && batch->index[j - 1] > index)); j--) {
+         batch->x[j] = batch->x[j - 1];
+         batch->index[j] = batch->index[j - 1];
+      }
+
+      batch->x[j] = x;
+      batch->index[j] = index;
+   }
+}
+
+/**
+ * \fn int findObjectSlot(ObjectBatch* batch, int x)
+ * \brief Find the first object of the batch whose x is at least the given one
+ *
+ * \param[in] batch: the batch, sorted by x
+ * \param[in] x: abscissa in pixels
+ * \return its place in the batch, batch->number if every object is before x
+ */
+int findObjectSlot(ObjectBatch* batch, int x) {
+
+   int first = 0, last = batch->number, middle;
+
+   while(first < last) {
+      middle = (first + last) / 2;
+
+      if(batch->x[middle] < x) first = middle + 1;
+      else last = middle;
+   }
+
+   return first;
+}
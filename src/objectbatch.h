@@ -0,0 +1,22 @@
+/**
+ * \file objectbatch.h
+ * \brief header of objectbatch.c
+ *
+ * Declaration of fillObjectBatches(), sortMonsterBatch() and findObjectSlot().
+ * The ObjectBatch structure is in game.h, with the Map.
+ *
+ * \author François-Xavier Balu, Gwendal Henry, Martin Parisot, Vincent Werner
+ */
+
+#ifndef OBJECTBATCH_H_INCLUDED
+#define OBJECTBATCH_H_INCLUDED
+
+#include "game.h"
+
+
+void fillObjectBatches(Map* map, GameObject* objects, int* groups, int objectNumber);
+void sortMonsterBatch(Map* map);
+int findObjectSlot(ObjectBatch* batch, int x);
+
+
+#endif // OBJECTBATCH_H_INCLUDED
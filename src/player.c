@@ -7,6 +7,8 @@
 #include "draw.h"
 #include "object.h"
 #include "menu.h"
+#include "render.h"
+#include "preload.h"
 
 
 GameObject* createPlayer(){
@@ -18,7 +20,7 @@ GameObject* createPlayer(){
     }
     else{
 
-        player->sprite = NULL;
+        player->clip = CLIP_IDLE;
         player->type = 0;
         player->spe = 0;
         player->initialized = 0;
@@ -44,10 +46,10 @@ GameObject* createPlayer(){
 }
 
 
-void initializePlayer(GameObject* player)
+void initializePlayer(GameObject* player, Game* game)
 {
-    /* Charge le sprite de notre héros */
-    changeAnimation(player,"data/graphics/walkright.png");
+    /* Animation de départ de notre héros */
+    changeAnimation(player, CLIP_WALK_RIGHT, game);
 
     //Indique l'état et la direction de notre héros
     player->direction = RIGHT;
@@ -100,11 +102,11 @@ void updatePlayer(GameObject *player, Game *game)
         player->direction = LEFT;
 
         //On teste le sens pour l'animation : si le joueur allait dans le sens contraire
-        //précédemment, il faut recharger le spritesheet pour l'animation.
+        //précédemment, il faut changer d'animation.
         if(player->etat != WALK_LEFT && player->onGround ==1)
         {
             player->etat = WALK_LEFT;
-            changeAnimation(player, "data/graphics/walkleft.png");
+            changeAnimation(player, CLIP_WALK_LEFT, game);
         }
     }
 
@@ -116,7 +118,7 @@ void updatePlayer(GameObject *player, Game *game)
         if(player->etat != WALK_RIGHT && player->onGround == 1)
         {
             player->etat =  WALK_RIGHT;
-            changeAnimation(player, "data/graphics/walkright.png");
+            changeAnimation(player, CLIP_WALK_RIGHT, game);
 
         }
 
@@ -126,7 +128,7 @@ void updatePlayer(GameObject *player, Game *game)
         if(player->etat!=IDLE)
         {
             player->etat = IDLE;
-            changeAnimation(player, "data/graphics/idle.png");
+            changeAnimation(player, CLIP_IDLE, game);
         }
 
     }
@@ -148,14 +150,14 @@ void updatePlayer(GameObject *player, Game *game)
        if(player->direction == RIGHT && player->etat != JUMP_RIGHT)
        {
             player->etat = JUMP_RIGHT;
-            changeAnimation(player, "data/graphics/jumpright.png");
+            changeAnimation(player, CLIP_JUMP_RIGHT, game);
 
 
        }
        else if(player->direction == LEFT && player->etat != JUMP_LEFT)
        {
             player->etat = JUMP_LEFT;
-            changeAnimation(player, "data/graphics/jumpleft.png");
+            changeAnimation(player, CLIP_JUMP_LEFT, game);
 
        }
 
@@ -228,25 +230,27 @@ void playerGameover(Game* game)
         sprintf(text, "Press ENTER");
         loadSong(1,"data/sounds/gameover.mp3",game);
 
-        while(game->input->enter == 0)
+        /* nobody to press ENTER in headless mode */
+        while(game->input->enter == 0 && game->headless == 0)
         {
         i = SDL_GetTicks();
 
         drawImage(game->gameover,0,0, game);
         drawString(text, 350, 400, 150, 150, 150, game->fontGameover,game);
-        SDL_Flip(game->screen);
+        presentScreen(game);
         while(SDL_GetTicks()-i != 500 && game->input->enter == 0)
         getInput(game->input,game);
         drawImage(game->gameover,0,0, game);
-        SDL_Flip(game->screen);
+        presentScreen(game);
         while(SDL_GetTicks()-i != 1000 && game->input->enter == 0)
         getInput(game->input,game);
 
         }
         game->input->enter = 0;
 
-        loadGame(game);
-        initializePlayer(game->player);
+        /* le niveau recommence dans son état de départ, sans être relu */
+        restartLevel(game);
+        initializePlayer(game->player, game);
 
     }
 
@@ -258,6 +262,15 @@ void endLevel(Game* game)
     int i;
     char text[200];
 
+    /* in headless mode, the run stops at the end of the level */
+    if(game->headless){
+        game->go = 0;
+        return;
+    }
+
+    /* le niveau suivant est ouvert par un thread pendant l'écran de fin de niveau */
+    sprintf(text, "data/map/map%d.tmx", game->level <= LEVEL_MAX ? game->level : 1);
+    preloadLevel(game->map->preload, text);
 
     sprintf(text, "Press ENTER to CONTINUE");
     loadSong(1,"data/music/Victory Theme (Faded).mp3",game);
@@ -269,11 +282,11 @@ void endLevel(Game* game)
 
     drawImage(game->endLevel,0,0, game);
     drawString(text, 160, 560, 250, 250, 250, game->fontGameover,game);
-    SDL_Flip(game->screen);
+    presentScreen(game);
     while(SDL_GetTicks()-i != 500 && game->input->enter == 0)
     getInput(game->input, game);
     drawImage(game->endLevel,0,0, game);
-    SDL_Flip(game->screen);
+    presentScreen(game);
     while(SDL_GetTicks()-i != 1000 && game->input->enter == 0)
     getInput(game->input,game);
 
@@ -282,7 +295,7 @@ void endLevel(Game* game)
 
     if(game->level <= LEVEL_MAX){
 
-        initializePlayer(game->player);
+        initializePlayer(game->player, game);
         loadGame(game);
     }
 
@@ -5,7 +5,7 @@
 
 
 
-void initializePlayer(GameObject *player);
+void initializePlayer(GameObject *player, Game* game);
 void updatePlayer(GameObject *player, Game *game);
 void centerScrollingOnPlayer(GameObject* player, Map* map);
 void playerGameover(Game* game);
@@ -0,0 +1,209 @@
+/**
+ * \file preload.c
+ * \brief contains the reading of the next level by a thread, while the player is still on a transition screen
+ *
+ * Implementation of createLevelPreload, preloadLevel, takePreloadedLevel and destroyLevelPreload.
+ *
+ * When the door of a level is reached, or a level is highlighted in the select menu, preloadLevel() asks
+ * a thread to open its cooked level (levelfile.h), cooking it first if the TMX file changed, and to read
+ * its pages from the disk. loadMap() then takes the level already open instead of opening it again.
+ *
+ * Only one level is read in advance: asking for another one gives back the previous one.
+ * A .lvl file is never cooked by the thread and the main thread at the same time: takePreloadedLevel()
+ * waits until the thread has finished the level it is reading.
+ *
+ * \author François-Xavier Balu, Gwendal Henry, Martin Parisot, Vincent Werner
+ */
+
+#include "preload.h"
+#include <sys/stat.h>
+
+/* pas entre deux octets lus pour faire venir en mémoire les pages d'un niveau projeté */
+#define PRELOAD_PAGE 4096
+
+
+/**
+ * \fn static void touchPages(const LevelFile* level)
+ * \brief Read one byte of each page of a mapped level, so that the disk is read now and not at the first frame
+ */
+static void touchPages(const LevelFile* level) {
+
+   volatile unsigned char sum = 0;
+   size_t i;
+
+   if(level == NULL || level->mapped == 0) return;
+
+   for(i = 0; i < level->size; i += PRELOAD_PAGE) sum += level->data[i];
+
+   (void)sum;
+}
+
+/**
+ * \fn static int preloadThread(void* data)
+ * \brief Open the levels asked by preloadLevel(), until destroyLevelPreload()
+ *
+ * \param[in, out] data: the LevelPreload structure
+ */
+static int preloadThread(void* data) {
+
+   LevelPreload* preload = (LevelPreload*)data;
+   LevelFile* level;
+   char name[PRELOAD_NAME_SIZE];
+
+   SDL_mutexP(preload->mutex);
+
+   for(;;) {
+
+      while(preload->requested == 0 && preload->quit == 0) SDL_CondWait(preload->condition, preload->mutex);
+
+      if(preload->quit) break;
+
+      strcpy(name, preload->name);
+      preload->requested = 0;
+      preload->busy = 1;
+      SDL_mutexV(preload->mutex);
+
+      if((level = openLevelFile(name)) == NULL) fprintf(stderr, "can't preload the level %s\n", name);
+
+      touchPages(level);
+
+      SDL_mutexP(preload->mutex);
+      preload->busy = 0;
+
+      /* un autre niveau a été demandé pendant la lecture : celui-ci n'est plus attendu */
+      if(preload->requested == 0 && strcmp(name, preload->name) == 0) {
+         preload->level = level;
+         level = NULL;
+      }
+
+      closeLevelFile(level);
+      SDL_CondBroadcast(preload->condition);
+   }
+
+   SDL_mutexV(preload->mutex);
+
+   return 0;
+}
+
+/**
+ * \fn LevelPreload* createLevelPreload()
+ * \brief Create the LevelPreload structure and start its thread
+ *
+ * If the allocation failed the function returns NULL.
+ * Without thread, nothing is read in advance: the levels are opened by loadMap().
+ */
+LevelPreload* createLevelPreload() {
+
+   LevelPreload* preload;
+
+   if((preload = (LevelPreload*)malloc(sizeof(LevelPreload))) == NULL) {
+      fprintf(stderr, "can't allocate memory for the preloading of the levels\n");
+
+      return NULL;
+   }
+
+   preload->name[0] = '\0';
+   preload->level = NULL;
+   preload->requested = 0;
+   preload->busy = 0;
+   preload->quit = 0;
+   preload->thread = NULL;
+
+   preload->mutex = SDL_CreateMutex();
+   preload->condition = SDL_CreateCond();
+
+   if(preload->mutex != NULL && preload->condition != NULL) {
+      preload->thread = SDL_CreateThread(preloadThread, preload);
+   }
+
+   if(preload->thread == NULL) fprintf(stderr, "Couldn't start the thread preloading the levels: %s\n", SDL_GetError());
+
+   return preload;
+}
+
+/**
+ * \fn void preloadLevel(LevelPreload* preload, const char* name)
+ * \brief Ask the thread to open a level in advance
+ *
+ * \param[in, out] preload
+ * \param[in] name: the TMX file of the level
+ *
+ * Nothing is done if this level is already asked, or if its TMX file doesn't exist (the select menu
+ * goes up to LEVEL_MAX, further than the last level). The level previously asked is given back.
+ */
+void preloadLevel(LevelPreload* preload, const char* name) {
+
+   LevelFile* previous = NULL;
+   struct stat info;
+
+   if(preload == NULL || preload->thread == NULL || strlen(name) >= PRELOAD_NAME_SIZE || stat(name, &info) != 0) return;
+
+   SDL_mutexP(preload->mutex);
+
+   if(strcmp(name, preload->name) != 0) {
+      previous = preload->level;
+      preload->level = NULL;
+      strcpy(preload->name, name);
+      preload->requested = 1;
+      SDL_CondBroadcast(preload->condition);
+   }
+
+   SDL_mutexV(preload->mutex);
+
+   closeLevelFile(previous);
+}
+
+/**
+ * \fn LevelFile* takePreloadedLevel(LevelPreload* preload, const char* name)
+ * \brief Give the level opened in advance, waiting for the thread if it is still reading it
+ *
+ * \param[in, out] preload
+ * \param[in] name: the TMX file of the level
+ * \return the cooked level, to close by the caller ; NULL if this level wasn't asked, or couldn't be opened
+ */
+LevelFile* takePreloadedLevel(LevelPreload* preload, const char* name) {
+
+   LevelFile* level = NULL;
+
+   if(preload == NULL || preload->thread == NULL) return NULL;
+
+   SDL_mutexP(preload->mutex);
+
+   /* le thread peut être en train de cuire le .lvl que le thread principal va ouvrir */
+   while(preload->busy || (preload->requested && strcmp(name, preload->name) == 0)) {
+      SDL_CondWait(preload->condition, preload->mutex);
+   }
+
+   if(strcmp(name, preload->name) == 0) {
+      level = preload->level;
+      preload->level = NULL;
+      preload->name[0] = '\0';
+   }
+
+   SDL_mutexV(preload->mutex);
+
+   return level;
+}
+
+/**
+ * \fn void destroyLevelPreload(LevelPreload* preload)
+ * \brief Stop the thread, then close the level read in advance and free the LevelPreload structure
+ */
+void destroyLevelPreload(LevelPreload* preload) {
+
+   if(preload == NULL) return;
+
+   if(preload->thread != NULL) {
+      SDL_mutexP(preload->mutex);
+      preload->quit = 1;
+      SDL_CondBroadcast(preload->condition);
+      SDL_mutexV(preload->mutex);
+
+      SDL_WaitThread(preload->thread, NULL);
+   }
+
+   closeLevelFile(preload->level);
+   SDL_DestroyCond(preload->condition);
+   SDL_DestroyMutex(preload->mutex);
+   free(preload);
+}
@@ -0,0 +1,46 @@
+/**
+ * \file preload.h
+ * \brief header of preload.c
+ *
+ * Creation of the LevelPreload structure.
+ * Declaration of createLevelPreload(), preloadLevel(), takePreloadedLevel() and destroyLevelPreload().
+ *
+ * \author François-Xavier Balu, Gwendal Henry, Martin Parisot, Vincent Werner
+ */
+
+#ifndef PRELOAD_H_INCLUDED
+#define PRELOAD_H_INCLUDED
+
+#include "common.h"
+#include "levelfile.h"
+#include <SDL_thread.h>
+
+/* taille maximale du nom du TMX demandé */
+#define PRELOAD_NAME_SIZE 200
+
+
+typedef struct LevelPreload{
+
+    /* TMX demandé, "" s'il n'y en a pas, et son niveau cuit une fois lu par le thread */
+    char name[PRELOAD_NAME_SIZE];
+    LevelFile *level;
+
+    /* 1 quand name est demandé et pas encore lu, 1 pendant que le thread lit un niveau */
+    int requested;
+    int busy;
+    int quit;
+
+    SDL_Thread *thread;
+    SDL_mutex *mutex;
+    SDL_cond *condition;
+
+}LevelPreload;
+
+
+LevelPreload* createLevelPreload();
+void preloadLevel(LevelPreload* preload, const char* name);
+LevelFile* takePreloadedLevel(LevelPreload* preload, const char* name);
+void destroyLevelPreload(LevelPreload* preload);
+
+
+#endif // PRELOAD_H_INCLUDED
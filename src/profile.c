@@ -0,0 +1,238 @@
+/**
+ * \file profile.c
+ * \brief contains the functions to time the sections of a frame
+ *
+ * Implementation of getTime, createProfile, startProfileFrame, markProfile, endProfileFrame,
+ * getProfileStats, getProfileSectionName and destroyProfile.
+ *
+ * Every function accepts a NULL Profile and does nothing, so the timing points can stay
+ * in the game code when nothing is measured.
+ *
+ * \author François-Xavier Balu, Gwendal Henry, Martin Parisot, Vincent Werner
+ */
+
+#include "common.h"
+#include "profile.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+
+/**
+ * \fn double getTime()
+ * \brief returns the time in milliseconds, with a sub-millisecond precision
+ *
+ * SDL_GetTicks() is too coarse to time a part of a frame.
+ */
+double getTime() {
+
+#ifdef _WIN32
+   LARGE_INTEGER counter, frequency;
+
+   QueryPerformanceCounter(&counter);
+   QueryPerformanceFrequency(&frequency);
+
+   return counter.QuadPart * 1000.0 / frequency.QuadPart;
+#else
+   struct timespec now;
+
+   clock_gettime(CLOCK_MONOTONIC, &now);
+
+   return now.tv_sec * 1000.0 + now.tv_nsec / 1000000.0;
+#endif
+}
+
+/**
+ * \fn Profile* createProfile()
+ * \brief Create the Profile structure
+ *
+ * the Profile structure is allocated and initialized.
+ * If the allocation failed the function returns NULL.
+ */
+Profile* createProfile() {
+
+   Profile* profile;
+   int i;
+
+   if((profile = (Profile*)malloc(sizeof(Profile))) == NULL) {
+      fprintf(stderr, "can't allocate memory for a profile\n");
+   } else {
+      for(i = 0; i < PROFILE_SECTION_NUMBER; i++) {
+         profile->samples[i] = NULL;
+      }
+
+      profile->frameNumber = 0;
+      profile->frameMax = 0;
+      profile->frameStart = 0;
+      profile->lastMark = 0;
+      profile->loadGame = 0;
+      profile->loadMap = 0;
+   }
+
+   return profile;
+}
+
+/**
+ * \fn void startProfileFrame(Profile* profile)
+ * \brief starts timing a new frame
+ *
+ * \param[in, out] profile: the Profile structure, or NULL
+ *
+ * If the allocation of the new frame fails, the program stops.
+ */
+void startProfileFrame(Profile* profile) {
+
+   int i;
+
+   if(profile == NULL) {
+      return;
+   }
+
+   if(profile->frameNumber == profile->frameMax) {
+
+      profile->frameMax = profile->frameMax == 0 ? 1024 : profile->frameMax*2;
+
+      for(i = 0; i < PROFILE_SECTION_NUMBER; i++) {
+
+         profile->samples[i] = (double*)realloc(profile->samples[i], profile->frameMax*sizeof(double));
+
+         if(profile->samples[i] == NULL) {
+            fprintf(stderr, "can't allocate memory for a profile\n");
+            exit(1);
+         }
+      }
+   }
+
+   for(i = 0; i < PROFILE_SECTION_NUMBER; i++) {
+      profile->samples[i][profile->frameNumber] = 0;
+   }
+
+   profile->frameStart = profile->lastMark = getTime();
+}
+
+/**
+ * \fn void markProfile(Profile* profile, int section)
+ * \brief adds the time elapsed since the last mark to a section of the current frame
+ *
+ * \param[in, out] profile: the Profile structure, or NULL
+ * \param[in] section: the section that just ended (PROFILE_INPUT, PROFILE_PLAYER...)
+ */
+void markProfile(Profile* profile, int section) {
+
+   double now;
+
+   if(profile == NULL || profile->frameNumber == profile->frameMax) {
+      return;
+   }
+
+   now = getTime();
+
+   profile->samples[section][profile->frameNumber] += now - profile->lastMark;
+   profile->lastMark = now;
+}
+
+/**
+ * \fn void endProfileFrame(Profile* profile)
+ * \brief ends the current frame and saves its total duration
+ *
+ * \param[in, out] profile: the Profile structure, or NULL
+ */
+void endProfileFrame(Profile* profile) {
+
+   if(profile == NULL || profile->frameNumber == profile->frameMax) {
+      return;
+   }
+
+   profile->samples[PROFILE_FRAME][profile->frameNumber] = getTime() - profile->frameStart;
+   profile->frameNumber++;
+}
+
+/**
+ * \fn static int compareDouble(const void* a, const void* b)
+ * \brief comparison function for qsort()
+ */
+static int compareDouble(const void* a, const void* b) {
+
+   double x = *(const double*)a, y = *(const double*)b;
+
+   return (x > y) - (x < y);
+}
+
+/**
+ * \fn void getProfileStats(Profile* profile, int section, ProfileStats* stats)
+ * \brief computes the mean and the tail durations of a section over every frame
+ *
+ * \param[in] profile: the Profile structure
+ * \param[in] section: the section
+ * \param[out] stats: mean, median, 95th and 99th percentiles and maximum, in milliseconds
+ */
+void getProfileStats(Profile* profile, int section, ProfileStats* stats) {
+
+   double* sorted;
+   double sum = 0;
+   int i, n = profile->frameNumber;
+
+   memset(stats, 0, sizeof(ProfileStats));
+
+   if(n == 0 || (sorted = (double*)malloc(n*sizeof(double))) == NULL) {
+      return;
+   }
+
+   memcpy(sorted, profile->samples[section], n*sizeof(double));
+   qsort(sorted, n, sizeof(double), compareDouble);
+
+   for(i = 0; i < n; i++) {
+      sum += sorted[i];
+   }
+
+   stats->mean = sum / n;
+   stats->median = sorted[(n-1)/2];
+   stats->p95 = sorted[(int)ceil(0.95*n) - 1];
+   stats->p99 = sorted[(int)ceil(0.99*n) - 1];
+   stats->max = sorted[n-1];
+
+   free(sorted);
+}
+
+/**
+ * \fn const char* getProfileSectionName(int section)
+ * \brief returns the name of a section, as written in the benchmark results
+ */
+const char* getProfileSectionName(int section) {
+
+   static const char* names[PROFILE_SECTION_NUMBER] = {
+      "input",
+      "update_player",
+      "update_object",
+      "draw_background",
+      "draw_map",
+      "draw_object",
+      "draw_player",
+      "draw_hud",
+      "draw_flip",
+      "frame"
+   };
+
+   return names[section];
+}
+
+/**
+ * \fn void destroyProfile(Profile* profile)
+ * \brief Free the Profile structure
+ *
+ * \param[in] profile: the Profile structure to free.
+ */
+void destroyProfile(Profile* profile) {
+
+   int i;
+
+   if(profile != NULL) {
+      for(i = 0; i < PROFILE_SECTION_NUMBER; i++) {
+         free(profile->samples[i]);
+      }
+      free(profile);
+   }
+}
@@ -0,0 +1,64 @@
+/**
+ * \file profile.h
+ * \brief header of profile.c
+ *
+ * Creation of the Profile structure.
+ * Declaration of getTime(), createProfile(), startProfileFrame(), markProfile(), endProfileFrame(),
+ * getProfileStats(), getProfileSectionName() and destroyProfile().
+ *
+ * \author François-Xavier Balu, Gwendal Henry, Martin Parisot, Vincent Werner
+ */
+
+#ifndef PROFILE_H_INCLUDED
+#define PROFILE_H_INCLUDED
+
+
+/* sections timées à chaque frame */
+enum
+{
+    PROFILE_INPUT,
+    PROFILE_PLAYER,
+    PROFILE_OBJECT,
+    PROFILE_DRAW_BACKGROUND,
+    PROFILE_DRAW_MAP,
+    PROFILE_DRAW_OBJECT,
+    PROFILE_DRAW_PLAYER,
+    PROFILE_DRAW_HUD,
+    PROFILE_DRAW_FLIP,
+    PROFILE_FRAME,
+    PROFILE_SECTION_NUMBER
+};
+
+
+typedef struct ProfileStats{
+
+    double mean, median, p95, p99, max;
+
+}ProfileStats;
+
+
+typedef struct Profile{
+
+    /* durée de chaque section (ms), une valeur par frame */
+    double *samples[PROFILE_SECTION_NUMBER];
+    int frameNumber, frameMax;
+
+    double frameStart, lastMark;
+
+    /* durées de chargement (ms) */
+    double loadGame, loadMap;
+
+}Profile;
+
+
+double getTime();
+Profile* createProfile();
+void startProfileFrame(Profile* profile);
+void markProfile(Profile* profile, int section);
+void endProfileFrame(Profile* profile);
+void getProfileStats(Profile* profile, int section, ProfileStats* stats);
+const char* getProfileSectionName(int section);
+void destroyProfile(Profile* profile);
+
+
+#endif // PROFILE_H_INCLUDED
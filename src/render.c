@@ -0,0 +1,719 @@
+/**
+ * \file render.c
+ * \brief contains the backend used to display the game
+ *
+ * Implementation of openScreen, beginFrame, setRenderLayer, drawSurface, drawOnSurface, endFrame, presentScreen,
+ * startRenderThread, syncRender, freeImage and closeScreen.
+ *
+ * Every drawing of the game goes through drawSurface() and presentScreen().
+ * The pictures are SDL surfaces, blitted on the screen surface by the CPU and shown with SDL_Flip().
+ *
+ * The frames of the levels are not drawn right away: between beginFrame() and endFrame(),
+ * drawSurface() only records a command. endFrame() sorts the commands by layer, then by picture,
+ * so the draws of a same picture follow each other, and executes them.
+ * drawOnSurface() records copies on other surfaces (the cache of the tiles): they are executed
+ * before every draw on the screen (layer RENDER_SURFACE).
+ * With startRenderThread(), they are executed by a render thread while the main thread
+ * updates the next frame. The commands hold everything needed to draw the frame, so the thread
+ * never reads the game. Two command buffers are used: one is recorded while the other is drawn.
+ * A picture can be used by the commands still being drawn, so it must be freed with freeImage(),
+ * and everything else drawing on the screen waits for the thread with syncRender().
+ *
+ * With SDL 1.2 and a screen in memory (no hardware double buffer), a frame is compared with the previous one:
+ * the draws which appeared or disappeared give the dirty rectangles (previous and new place of the sprites,
+ * numbers of the HUD...). Only the draws touching these rectangles are done again, clipped to them,
+ * and only these rectangles are sent to the display with SDL_UpdateRects(). The whole frame is drawn
+ * and flipped when the camera moved (the cache of the tiles is modified), when the rectangles cover
+ * more than DIRTY_COVERAGE_MAX percents of the screen, or when something was drawn outside of a frame.
+ *
+ * \author François-Xavier Balu, Gwendal Henry, Martin Parisot, Vincent Werner
+ */
+
+#include "render.h"
+#include "blit.h"
+#include <SDL_thread.h>
+#include <stdint.h>     /* uintptr_t */
+
+
+typedef struct RenderCommand{
+
+    /* target NULL : dessin sur l'écran, sinon copie sur target (image NULL : effacement) */
+    SDL_Surface *image, *target;
+    SDL_Rect src, dest;
+    int whole;
+
+    /* clés du tri : couche, image (par ordre de première utilisation), ordre d'enregistrement */
+    int layer, slot, order;
+
+}RenderCommand;
+
+
+typedef struct CommandBuffer{
+
+    RenderCommand *commands;
+    int number, max;
+
+    /* 1 si l'écran doit être entièrement redessiné */
+    int full;
+
+}CommandBuffer;
+
+
+/* buffers[recording] est enregistré, l'autre est dessiné par le thread */
+static CommandBuffer buffers[2];
+static int recording = 0;
+static int isRecording = 0;
+static int currentLayer = RENDER_BACKGROUND;
+
+/* dernière frame dessinée et frame à dessiner, rangées par contenu, et rectangles modifiés
+   (seulement dans le thread qui dessine) */
+static CommandBuffer previous, current;
+static SDL_Rect dirtyRects[DIRTY_RECT_MAX];
+
+/* quelque chose a été dessiné hors d'une frame : la prochaine sera entière */
+static int fullFrame = 1;
+
+/* thread de rendu */
+static SDL_Thread *thread = NULL;
+static SDL_mutex *mutex = NULL;
+static SDL_cond *condition = NULL;
+static int pending = 0, quit = 0;
+
+
+/**
+ * \fn void openScreen(char* title, Game* game)
+ * \brief Create the window of the game, or an offscreen screen in headless mode
+ *
+ * \param[in] title: title of the window.
+ * \param[in, out] game: pointer to the Game structure.
+ *
+ * SDL must have been initialized. Exits if the screen can't be created.
+ */
+void openScreen(char* title, Game* game) {
+
+   /* On crée la fenêtre, représentée par le pointeur jeu.screen en utilisant la largeur et la
+   hauteur définies dans les defines (defs.h). On utilise aussi la mémoire vidéo
+   (SDL_HWPALETTE) et le double buffer pour éviter que ça scintille
+   (SDL_DOUBLEBUF) */
+
+   if(game->headless) {
+      game->screen = SDL_SetVideoMode(SCREEN_WIDTH,SCREEN_HEIGHT,32,SDL_SWSURFACE);
+   } else {
+      game->screen = SDL_SetVideoMode(SCREEN_WIDTH,SCREEN_HEIGHT,0,SDL_HWPALETTE|SDL_DOUBLEBUF);
+   }
+
+   if(game->screen == NULL) {
+      printf("Couldn't set screen mode to %d x %d: %s\n", SCREEN_WIDTH, SCREEN_HEIGHT, SDL_GetError());
+      exit(1);
+   }
+
+   if(game->headless == 0) {
+      SDL_WM_SetCaption(title,NULL); /*on affiche le titre de la fenetre*/
+
+      SDL_ShowCursor(SDL_DISABLE);
+   }
+}
+
+/**
+ * \fn static void blit(SDL_Surface* image, SDL_Rect* src, SDL_Rect* dest, SDL_Surface* screen)
+ * \brief draws a picture right away
+ */
+static void blit(SDL_Surface* image, SDL_Rect* src, SDL_Rect* dest, SDL_Surface* screen) {
+
+   /* les images avec un canal alpha sont mélangées par alphaBlit(), plus rapide */
+   if(canAlphaBlit(image, screen)) alphaBlit(image, src, screen, dest);
+   else SDL_BlitSurface(image, src, screen, dest);
+}
+
+/**
+ * \fn static void copySurface(SDL_Surface* image, SDL_Rect* src, SDL_Surface* target, SDL_Rect* dest)
+ * \brief copies a picture on a surface right away, without blending, or clears a rectangle if image is NULL
+ */
+static void copySurface(SDL_Surface* image, SDL_Rect* src, SDL_Surface* target, SDL_Rect* dest) {
+
+   Uint32 flags;
+   Uint8 alpha;
+
+   if(image == NULL) {
+      SDL_FillRect(target, dest, 0);
+   } else if(canCopyBlit(image, target)) {
+      copyBlit(image, src, target, dest);
+   } else {
+      /* le canal alpha est copié tel quel */
+      flags = image->flags & SDL_SRCALPHA;
+      alpha = image->format->alpha;
+      SDL_SetAlpha(image, 0, alpha);
+      SDL_BlitSurface(image, src, target, dest);
+      SDL_SetAlpha(image, flags, alpha);
+   }
+}
+
+/**
+ * \fn static int compareCommands(const void* a, const void* b)
+ * \brief order of the commands: by layer, then by picture, then in the order they were recorded
+ */
+static int compareCommands(const void* a, const void* b) {
+
+   const RenderCommand *first = (const RenderCommand*)a, *second = (const RenderCommand*)b;
+
+   if(first->layer != second->layer) return first->layer - second->layer;
+   if(first->slot != second->slot) return first->slot - second->slot;
+
+   return first->order - second->order;
+}
+
+/**
+ * \fn static int compareContents(const void* a, const void* b)
+ * \brief qsort function ordering the commands by what they draw and where, 0 if they draw the same thing at the same place
+ *
+ * Unlike compareCommands(), this order doesn't depend on the other commands of the frame,
+ * so two frames sorted with it can be compared in one pass.
+ */
+static int compareContents(const void* a, const void* b) {
+
+   const RenderCommand *first = (const RenderCommand*)a, *second = (const RenderCommand*)b;
+
+   if(first->layer != second->layer) return first->layer - second->layer;
+   if(first->image != second->image) return (uintptr_t)first->image < (uintptr_t)second->image ? -1 : 1;
+   if(first->target != second->target) return (uintptr_t)first->target < (uintptr_t)second->target ? -1 : 1;
+   if(first->whole != second->whole) return first->whole - second->whole;
+   if(first->dest.y != second->dest.y) return first->dest.y - second->dest.y;
+   if(first->dest.x != second->dest.x) return first->dest.x - second->dest.x;
+
+   /* une image entière ne dépend pas de src */
+   if(first->whole) return 0;
+
+   if(first->src.y != second->src.y) return first->src.y - second->src.y;
+   if(first->src.x != second->src.x) return first->src.x - second->src.x;
+   if(first->src.h != second->src.h) return first->src.h - second->src.h;
+
+   return first->src.w - second->src.w;
+}
+
+/**
+ * \fn static void getCommandRect(RenderCommand* command, SDL_Surface* screen, SDL_Rect* rect)
+ * \brief gives the part of the screen a command can modify
+ */
+static void getCommandRect(RenderCommand* command, SDL_Surface* screen, SDL_Rect* rect) {
+
+   int x1 = command->dest.x, y1 = command->dest.y, x2, y2;
+
+   /* une copie sur une autre surface ne modifie pas l'écran */
+   if(command->target != NULL) {
+      rect->x = rect->y = 0;
+      rect->w = rect->h = 0;
+
+      return;
+   }
+
+   x2 = x1 + (command->whole ? command->image->w : command->src.w);
+   y2 = y1 + (command->whole ? command->image->h : command->src.h);
+
+   if(x1 < 0) x1 = 0;
+   if(y1 < 0) y1 = 0;
+   if(x2 > screen->w) x2 = screen->w;
+   if(y2 > screen->h) y2 = screen->h;
+
+   rect->x = x1;
+   rect->y = y1;
+   rect->w = x2 > x1 ? x2 - x1 : 0;
+   rect->h = y2 > y1 ? y2 - y1 : 0;
+}
+
+/**
+ * \fn static int touchRects(SDL_Rect* a, SDL_Rect* b)
+ * \brief tells if two rectangles overlap or touch each other
+ */
+static int touchRects(SDL_Rect* a, SDL_Rect* b) {
+
+   return a->x <= b->x + b->w && b->x <= a->x + a->w && a->y <= b->y + b->h && b->y <= a->y + a->h;
+}
+
+/**
+ * \fn static int addDirtyRect(SDL_Rect* rect, int number)
+ * \brief adds a rectangle to dirtyRects, merged with the ones it touches
+ *
+ * Returns the new number of rectangles, or -1 if there are more than DIRTY_RECT_MAX.
+ */
+static int addDirtyRect(SDL_Rect* rect, int number) {
+
+   SDL_Rect merged = *rect;
+   int i, x2, y2;
+
+   if(merged.w == 0 || merged.h == 0) return number;
+
+   /* fusionne avec les rectangles touchés, jusqu'à ce qu'il n'y en ait plus */
+   for(i = 0; i < number; i++) {
+      if(touchRects(&merged, &dirtyRects[i]) == 0) continue;
+
+      x2 = merged.x + merged.w > dirtyRects[i].x + dirtyRects[i].w ? merged.x + merged.w : dirtyRects[i].x + dirtyRects[i].w;
+      y2 = merged.y + merged.h > dirtyRects[i].y + dirtyRects[i].h ? merged.y + merged.h : dirtyRects[i].y + dirtyRects[i].h;
+      if(dirtyRects[i].x < merged.x) merged.x = dirtyRects[i].x;
+      if(dirtyRects[i].y < merged.y) merged.y = dirtyRects[i].y;
+      merged.w = x2 - merged.x;
+      merged.h = y2 - merged.y;
+
+      dirtyRects[i] = dirtyRects[--number];
+      i = -1;
+   }
+
+   if(number == DIRTY_RECT_MAX) return -1;
+
+   dirtyRects[number] = merged;
+
+   return number + 1;
+}
+
+/**
+ * \fn static void sortCommands(CommandBuffer* buffer)
+ * \brief copies the frame to draw in current, sorted by compareContents()
+ */
+static void sortCommands(CommandBuffer* buffer) {
+
+   RenderCommand* commands;
+
+   if(buffer->number > current.max) {
+      if((commands = (RenderCommand*)realloc(current.commands, buffer->number * sizeof(RenderCommand))) == NULL) {
+         fprintf(stderr, "can't allocate memory for the render commands\n");
+
+         /* sans copie, tout sera nouveau dans la prochaine frame, qui sera entière */
+         current.number = 0;
+         current.full = 1;
+
+         return;
+      }
+
+      current.commands = commands;
+      current.max = buffer->number;
+   }
+
+   memcpy(current.commands, buffer->commands, buffer->number * sizeof(RenderCommand));
+   current.number = buffer->number;
+   current.full = 0;
+
+   qsort(current.commands, current.number, sizeof(RenderCommand), compareContents);
+}
+
+/**
+ * \fn static int findDirtyRects(CommandBuffer* buffer, SDL_Surface* screen)
+ * \brief compares a frame with the previous one and fills dirtyRects
+ *
+ * Both frames are sorted by compareContents(): one pass over them finds the draws which appeared or disappeared.
+ * Returns the number of dirty rectangles, or -1 if the whole screen must be drawn.
+ */
+static int findDirtyRects(CommandBuffer* buffer, SDL_Surface* screen) {
+
+   RenderCommand* command;
+   SDL_Rect rect;
+   int i = 0, j = 0, difference, number = 0, area = 0;
+
+   sortCommands(buffer);
+
+   if(buffer->full || current.full || (screen->flags & SDL_DOUBLEBUF) == SDL_DOUBLEBUF) return -1;
+
+   while((i < current.number || j < previous.number) && number >= 0) {
+
+      if(i == current.number) difference = 1;
+      else if(j == previous.number) difference = -1;
+      else difference = compareContents(&(current.commands[i]), &(previous.commands[j]));
+
+      if(difference == 0) {
+         i++;
+         j++;
+
+         continue;
+      }
+
+      /* nouveau dessin, ou dessin disparu */
+      command = difference < 0 ? &(current.commands[i++]) : &(previous.commands[j++]);
+
+      /* le cache des tiles a changé : la caméra a bougé */
+      if(command->target != NULL) return -1;
+
+      getCommandRect(command, screen, &rect);
+      number = addDirtyRect(&rect, number);
+   }
+
+   for(i = 0; i < number; i++) area += dirtyRects[i].w * dirtyRects[i].h;
+
+   if(number < 0 || area * 100 > screen->w * screen->h * DIRTY_COVERAGE_MAX) return -1;
+
+   return number;
+}
+
+/**
+ * \fn static void keepCommands()
+ * \brief keeps the frame drawn, sorted by sortCommands(), to compare it with the next one
+ */
+static void keepCommands() {
+
+   CommandBuffer kept = previous;
+
+   previous = current;
+   current = kept;
+}
+
+
+/**
+ * \fn static void executeCommand(RenderCommand* command, SDL_Surface* screen)
+ * \brief draws one command, without modifying it (it is compared with the next frame)
+ */
+static void executeCommand(RenderCommand* command, SDL_Surface* screen) {
+
+   SDL_Rect dest = command->dest;
+
+   if(command->target != NULL) {
+      copySurface(command->image, command->whole ? NULL : &(command->src), command->target, &dest);
+   } else {
+      blit(command->image, command->whole ? NULL : &(command->src), &dest, screen);
+   }
+}
+
+/**
+ * \fn static void executeCommands(CommandBuffer* buffer, SDL_Surface* screen)
+ * \brief draws the commands of a buffer and shows the frame
+ */
+static void executeCommands(CommandBuffer* buffer, SDL_Surface* screen) {
+
+   SDL_Rect rect;
+   int i, j, number = findDirtyRects(buffer, screen);
+
+   if(number < 0) {
+      for(i = 0; i < buffer->number; i++) executeCommand(&(buffer->commands[i]), screen);
+
+      SDL_Flip(screen);
+   } else if(number > 0) {
+      /* seulement les dessins qui touchent un rectangle modifié, découpés par lui */
+      for(j = 0; j < number; j++) {
+         SDL_SetClipRect(screen, &dirtyRects[j]);
+
+         for(i = 0; i < buffer->number; i++) {
+            getCommandRect(&(buffer->commands[i]), screen, &rect);
+
+            if(rect.w > 0 && rect.h > 0 && touchRects(&rect, &dirtyRects[j])) executeCommand(&(buffer->commands[i]), screen);
+         }
+      }
+
+      SDL_SetClipRect(screen, NULL);
+      SDL_UpdateRects(screen, number, dirtyRects);
+   }
+
+   keepCommands();
+}
+
+/**
+ * \fn static int renderThread(void* data)
+ * \brief main function of the render thread: draws the buffers given by endFrame()
+ *
+ * \param[in] data: the screen
+ */
+static int renderThread(void* data) {
+
+   SDL_mutexP(mutex);
+
+   while(1) {
+      while(pending == 0 && quit == 0) SDL_CondWait(condition, mutex);
+
+      if(pending == 0) break;
+
+      SDL_mutexV(mutex);
+
+      executeCommands(&buffers[1 - recording], (SDL_Surface*)data);
+
+      SDL_mutexP(mutex);
+
+      pending = 0;
+      SDL_CondBroadcast(condition);
+   }
+
+   SDL_mutexV(mutex);
+
+   return 0;
+}
+
+/**
+ * \fn void beginFrame()
+ * \brief starts recording the draws of a frame
+ *
+ * Until endFrame(), drawSurface() records the draws instead of doing them.
+ */
+void beginFrame() {
+
+   buffers[recording].number = 0;
+   currentLayer = RENDER_BACKGROUND;
+   isRecording = 1;
+}
+
+/**
+ * \fn void setRenderLayer(int layer)
+ * \brief sets the layer of the next draws
+ *
+ * \param[in] layer: RENDER_*, the layers are drawn in this order.
+ */
+void setRenderLayer(int layer) {
+
+   currentLayer = layer;
+}
+
+/**
+ * \fn static void recordCommand(SDL_Surface* image, SDL_Rect* src, SDL_Surface* target, SDL_Rect* dest, int layer)
+ * \brief adds a command to the buffer being recorded
+ */
+static void recordCommand(SDL_Surface* image, SDL_Rect* src, SDL_Surface* target, SDL_Rect* dest, int layer) {
+
+   CommandBuffer* buffer = &buffers[recording];
+   RenderCommand* command;
+   int i;
+
+   if(buffer->number == buffer->max) {
+      i = buffer->max > 0 ? buffer->max * 2 : 256;
+
+      if((command = (RenderCommand*)realloc(buffer->commands, i * sizeof(RenderCommand))) == NULL) {
+         fprintf(stderr, "can't allocate memory for the render commands\n");
+
+         return;
+      }
+
+      buffer->commands = command;
+      buffer->max = i;
+   }
+
+   command = &(buffer->commands[buffer->number]);
+
+   command->image = image;
+   command->target = target;
+   command->whole = (src == NULL);
+   if(src != NULL) command->src = *src;
+   command->dest = *dest;
+   command->layer = layer;
+   command->order = buffer->number;
+
+   /* même numéro que la première commande de la couche qui utilise cette image */
+   command->slot = buffer->number;
+
+   for(i = buffer->number - 1; i >= 0 && buffer->commands[i].layer == layer; i--) {
+      if(buffer->commands[i].image == image) {
+         command->slot = buffer->commands[i].slot;
+         break;
+      }
+   }
+
+   buffer->number++;
+}
+
+/**
+ * \fn void drawSurface(SDL_Surface* image, SDL_Rect* src, SDL_Rect* dest, Game* game)
+ * \brief displays a picture, or a part of it, on the screen
+ *
+ * \param[in] image: the picture.
+ * \param[in] src: the part of the picture to display, NULL for all of it.
+ * \param[in] dest: position on the screen, only x and y are used.
+ * \param[in] game: contains the screen.
+ *
+ * Between beginFrame() and endFrame(), the draw is only recorded.
+ */
+void drawSurface(SDL_Surface* image, SDL_Rect* src, SDL_Rect* dest, Game* game) {
+
+   if(isRecording == 0) {
+      syncRender();
+      blit(image, src, dest, game->screen);
+      fullFrame = 1;
+
+      return;
+   }
+
+   recordCommand(image, src, NULL, dest, currentLayer);
+}
+
+/**
+ * \fn void drawOnSurface(SDL_Surface* image, SDL_Rect* src, SDL_Surface* target, SDL_Rect* dest)
+ * \brief copies a picture, or a part of it, on another surface, without blending
+ *
+ * \param[in] image: the picture, its alpha channel is copied too. NULL to make dest transparent (black).
+ * \param[in] src: the part of the picture to copy, NULL for all of it.
+ * \param[in, out] target: the surface modified, drawn afterwards with drawSurface().
+ * \param[in] dest: position on the target, with the size of the rectangle to clear when image is NULL.
+ *
+ * Between beginFrame() and endFrame(), the copy is recorded and done before the draws on the screen,
+ * so the render thread never draws a surface being modified.
+ */
+void drawOnSurface(SDL_Surface* image, SDL_Rect* src, SDL_Surface* target, SDL_Rect* dest) {
+
+   if(isRecording == 0) {
+      syncRender();
+      copySurface(image, src, target, dest);
+
+      return;
+   }
+
+   recordCommand(image, src, target, dest, RENDER_SURFACE);
+}
+
+/**
+ * \fn void endFrame(Game* game)
+ * \brief sorts the draws recorded since beginFrame() and shows them on the screen
+ *
+ * \param[in] game: contains the screen.
+ *
+ * With the render thread, the frame is given to the thread, which draws it while the game goes on.
+ */
+void endFrame(Game* game) {
+
+   isRecording = 0;
+
+   buffers[recording].full = fullFrame;
+   fullFrame = 0;
+
+   qsort(buffers[recording].commands, buffers[recording].number, sizeof(RenderCommand), compareCommands);
+
+   if(thread == NULL) {
+      executeCommands(&buffers[recording], game->screen);
+
+      return;
+   }
+
+   /* le thread a fini la frame précédente : il prend celle-ci, la suivante s'enregistre dans l'autre buffer */
+   SDL_mutexP(mutex);
+
+   while(pending) SDL_CondWait(condition, mutex);
+
+   recording = 1 - recording;
+   pending = 1;
+   SDL_CondBroadcast(condition);
+
+   SDL_mutexV(mutex);
+}
+
+/**
+ * \fn void presentScreen(Game* game)
+ * \brief shows on the screen everything drawn since the last call
+ *
+ * \param[in] game: contains the screen.
+ */
+void presentScreen(Game* game) {
+
+   syncRender();
+
+   fullFrame = 1;
+
+   SDL_Flip(game->screen);
+}
+
+/**
+ * \fn int startRenderThread(Game* game)
+ * \brief starts the thread drawing the frames of the levels
+ *
+ * \param[in] game: contains the screen, created by openScreen().
+ *
+ * Returns 1 if the thread is started, 0 if the frames stay drawn by the main thread.
+ */
+int startRenderThread(Game* game) {
+
+   if(thread != NULL) return 1;
+
+   mutex = SDL_CreateMutex();
+   condition = SDL_CreateCond();
+   pending = 0;
+   quit = 0;
+
+   if(mutex == NULL || condition == NULL || (thread = SDL_CreateThread(renderThread, game->screen)) == NULL) {
+      printf("Couldn't start the render thread: %s\n", SDL_GetError());
+
+      SDL_DestroyCond(condition);
+      SDL_DestroyMutex(mutex);
+      condition = NULL;
+      mutex = NULL;
+
+      return 0;
+   }
+
+   return 1;
+}
+
+/**
+ * \fn void syncRender()
+ * \brief waits until the render thread has drawn the last frame given by endFrame()
+ *
+ * Afterwards the screen and the pictures can be used by the main thread.
+ */
+void syncRender() {
+
+   if(thread == NULL) return;
+
+   SDL_mutexP(mutex);
+
+   while(pending) SDL_CondWait(condition, mutex);
+
+   SDL_mutexV(mutex);
+}
+
+/**
+ * \fn void freeImage(SDL_Surface* image)
+ * \brief Free a picture
+ *
+ * \param[in] image: the picture, may be NULL.
+ *
+ * To use instead of SDL_FreeSurface() for the surfaces given to drawSurface().
+ * Waits until the render thread doesn't use the picture anymore.
+ */
+void freeImage(SDL_Surface* image) {
+
+   if(image == NULL) return;
+
+   syncRender();
+
+   /* un nouveau dessin pourrait recevoir la même adresse */
+   fullFrame = 1;
+
+
+   SDL_FreeSurface(image);
+}
+
+/**
+ * \fn void closeScreen(Game* game)
+ * \brief Close the window of the game
+ *
+ * \param[in, out] game: pointer to the Game structure.
+ *
+ * Stops the render thread. The pictures must have been freed with freeImage() before.
+ */
+void closeScreen(Game* game) {
+
+   int i;
+
+   if(thread != NULL) {
+      SDL_mutexP(mutex);
+      quit = 1;
+      SDL_CondBroadcast(condition);
+      SDL_mutexV(mutex);
+
+      SDL_WaitThread(thread, NULL);
+      SDL_DestroyCond(condition);
+      SDL_DestroyMutex(mutex);
+
+      thread = NULL;
+      condition = NULL;
+      mutex = NULL;
+   }
+
+   for(i = 0; i < 2; i++) {
+      free(buffers[i].commands);
+      buffers[i].commands = NULL;
+      buffers[i].number = 0;
+      buffers[i].max = 0;
+   }
+
+   free(previous.commands);
+   previous.commands = NULL;
+   previous.number = 0;
+   previous.max = 0;
+   free(current.commands);
+   current.commands = NULL;
+   current.number = 0;
+   current.max = 0;
+   fullFrame = 1;
+
+
+   SDL_FreeSurface(game->screen);
+   game->screen = NULL;
+}
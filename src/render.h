@@ -0,0 +1,46 @@
+/**
+ * \file render.h
+ * \brief header of render.c
+ *
+ * Declaration of openScreen(), beginFrame(), setRenderLayer(), drawSurface(), drawOnSurface(), endFrame(), presentScreen(),
+ * startRenderThread(), syncRender(), freeImage() and closeScreen().
+ *
+ * \author François-Xavier Balu, Gwendal Henry, Martin Parisot, Vincent Werner
+ */
+
+#ifndef RENDER_H_INCLUDED
+#define RENDER_H_INCLUDED
+
+#include "game.h"
+
+
+/* au-delà, l'écran entier est redessiné : nombre de rectangles modifiés, pourcentage de l'écran couvert */
+#define DIRTY_RECT_MAX 32
+#define DIRTY_COVERAGE_MAX 50
+
+/* couches d'une frame, dessinées dans cet ordre */
+enum
+{
+    RENDER_SURFACE,
+    RENDER_BACKGROUND,
+    RENDER_MAP,
+    RENDER_OBJECT,
+    RENDER_PLAYER,
+    RENDER_HUD
+};
+
+
+void openScreen(char* title, Game* game);
+void beginFrame();
+void setRenderLayer(int layer);
+void drawSurface(SDL_Surface* image, SDL_Rect* src, SDL_Rect* dest, Game* game);
+void drawOnSurface(SDL_Surface* image, SDL_Rect* src, SDL_Surface* target, SDL_Rect* dest);
+void endFrame(Game* game);
+void presentScreen(Game* game);
+int startRenderThread(Game* game);
+void syncRender();
+void freeImage(SDL_Surface* image);
+void closeScreen(Game* game);
+
+
+#endif // RENDER_H_INCLUDED
@@ -0,0 +1,541 @@
+/**
+ * \file replay.c
+ * \brief contains the functions to record a game session and to play it again
+ *
+ * Implementation of createReplay, startRecording, recordInput, recordHash, saveReplay, loadReplay,
+ * startReplay, getReplayInput, checkReplayHash, hashGame and destroyReplay.
+ *
+ * The game only depends on the Input structure, so saving the inputs of every frame is enough
+ * to play a session again. A hash of the game state is saved with each frame to detect
+ * when a replay diverges from the recorded session.
+ *
+ * File format (integers are little endian):
+ * - "NCPR", version (1 byte)
+ * - level, onMenu, x, y, life, coin, number of frames (4 bytes each)
+ * - inputs: list of (number of frames as a varint, input mask) until every frame is covered
+ * - one hash per frame (4 bytes each)
+ *
+ * \author François-Xavier Balu, Gwendal Henry, Martin Parisot, Vincent Werner
+ */
+
+#include "replay.h"
+#include "map.h"
+#include "player.h"
+#include "menu.h"
+
+
+/**
+ * \fn static unsigned char packInput(Input* input)
+ * \brief packs the Input structure into one byte, one bit per key
+ *
+ * \param[in] input: the Input structure to pack
+ */
+static unsigned char packInput(Input* input) {
+
+   return (input->left != 0)
+          | (input->right != 0) << 1
+          | (input->up != 0) << 2
+          | (input->down != 0) << 3
+          | (input->jump != 0) << 4
+          | (input->use != 0) << 5
+          | (input->enter != 0) << 6
+          | (input->pause != 0) << 7;
+}
+
+/**
+ * \fn static void unpackInput(unsigned char mask, Input* input)
+ * \brief fills the Input structure from a byte made by packInput()
+ *
+ * \param[in] mask: the packed inputs
+ * \param[out] input: the Input structure to fill
+ */
+static void unpackInput(unsigned char mask, Input* input) {
+
+   input->left = mask & 1;
+   input->right = (mask >> 1) & 1;
+   input->up = (mask >> 2) & 1;
+   input->down = (mask >> 3) & 1;
+   input->jump = (mask >> 4) & 1;
+   input->use = (mask >> 5) & 1;
+   input->enter = (mask >> 6) & 1;
+   input->pause = (mask >> 7) & 1;
+}
+
+/**
+ * \fn static void writeInt(FILE* file, unsigned int value)
+ * \brief writes a 4 bytes little endian integer
+ */
+static void writeInt(FILE* file, unsigned int value) {
+
+   fputc(value & 0xFF, file);
+   fputc((value >> 8) & 0xFF, file);
+   fputc((value >> 16) & 0xFF, file);
+   fputc((value >> 24) & 0xFF, file);
+}
+
+/**
+ * \fn static int readInt(FILE* file, unsigned int* value)
+ * \brief reads a 4 bytes little endian integer
+ *
+ * Returns 0 at the end of the file, 1 otherwise.
+ */
+static int readInt(FILE* file, unsigned int* value) {
+
+   unsigned char bytes[4];
+
+   if(fread(bytes, 1, 4, file) != 4) {
+      return 0;
+   }
+
+   *value = bytes[0] | bytes[1] << 8 | bytes[2] << 16 | (unsigned int)bytes[3] << 24;
+
+   return 1;
+}
+
+/**
+ * \fn static void writeVarint(FILE* file, unsigned int value)
+ * \brief writes an integer on as few bytes as possible (7 bits per byte)
+ */
+static void writeVarint(FILE* file, unsigned int value) {
+
+   while(value >= 0x80) {
+      fputc((value & 0x7F) | 0x80, file);
+      value >>= 7;
+   }
+
+   fputc(value, file);
+}
+
+/**
+ * \fn static int readVarint(FILE* file, unsigned int* value)
+ * \brief reads an integer written by writeVarint()
+ *
+ * Returns 0 at the end of the file, 1 otherwise.
+ */
+static int readVarint(FILE* file, unsigned int* value) {
+
+   int c, shift = 0;
+
+   *value = 0;
+
+   do {
+      if((c = fgetc(file)) == EOF || shift > 28) {
+         return 0;
+      }
+
+      *value |= (unsigned int)(c & 0x7F) << shift;
+      shift += 7;
+
+   } while(c & 0x80);
+
+   return 1;
+}
+
+/**
+ * \fn static unsigned int hashInt(unsigned int hash, int value)
+ * \brief adds the four bytes of an integer to a FNV-1a hash
+ */
+static unsigned int hashInt(unsigned int hash, int value) {
+
+   int i;
+
+   for(i = 0; i < 4; i++) {
+      hash ^= ((unsigned int)value >> (8*i)) & 0xFF;
+      hash *= 16777619u;
+   }
+
+   return hash;
+}
+
+/**
+ * \fn static unsigned int hashFloat(unsigned int hash, float value)
+ * \brief adds the bits of a float to a FNV-1a hash
+ */
+static unsigned int hashFloat(unsigned int hash, float value) {
+
+   int bits;
+
+   memcpy(&bits, &value, sizeof(int));
+
+   return hashInt(hash, bits);
+}
+
+/**
+ * \fn static void growReplay(Replay* replay)
+ * \brief makes room for one more frame in the Replay structure
+ *
+ * If the allocation fails, the program stops.
+ */
+static void growReplay(Replay* replay) {
+
+   if(replay->frameNumber < replay->frameMax) {
+      return;
+   }
+
+   replay->frameMax = replay->frameMax == 0 ? 1024 : replay->frameMax*2;
+   replay->inputs = (unsigned char*)realloc(replay->inputs, replay->frameMax*sizeof(unsigned char));
+   replay->hashes = (unsigned int*)realloc(replay->hashes, replay->frameMax*sizeof(unsigned int));
+
+   if(replay->inputs == NULL || replay->hashes == NULL) {
+      fprintf(stderr, "can't allocate memory for a replay\n");
+      exit(1);
+   }
+}
+
+
+/**
+ * \fn Replay* createReplay()
+ * \brief Create the Replay structure
+ *
+ * the Replay structure is allocated and initialized.
+ * If the allocation failed the function returns NULL.
+ */
+Replay* createReplay() {
+
+   Replay* replay;
+
+   if((replay = (Replay*)malloc(sizeof(Replay))) == NULL) {
+      fprintf(stderr, "can't allocate memory for a replay\n");
+   } else {
+      replay->level = 0;
+      replay->onMenu = 0;
+      replay->x = 0;
+      replay->y = 0;
+      replay->life = 0;
+      replay->coin = 0;
+      replay->inputs = NULL;
+      replay->hashes = NULL;
+      replay->frameNumber = 0;
+      replay->frameMax = 0;
+      replay->current = 0;
+   }
+
+   return replay;
+}
+
+/**
+ * \fn void startRecording(Replay* replay, Game* game)
+ * \brief saves the initial state of the session
+ *
+ * \param[in, out] replay: the Replay structure that will record the session
+ * \param[in] game: the game, already loaded
+ *
+ * Forgets the frames recorded before.
+ */
+void startRecording(Replay* replay, Game* game) {
+
+   replay->level = game->level;
+   replay->onMenu = game->onMenu;
+   replay->x = game->player->x;
+   replay->y = game->player->y;
+   replay->life = game->life;
+   replay->coin = game->coin;
+
+   replay->frameNumber = 0;
+   replay->current = 0;
+}
+
+/**
+ * \fn void recordInput(Replay* replay, Input* input)
+ * \brief records the inputs of a new frame
+ *
+ * \param[in, out] replay: the Replay structure
+ * \param[in] input: the inputs read for this frame, before the game uses them
+ */
+void recordInput(Replay* replay, Input* input) {
+
+   growReplay(replay);
+
+   replay->inputs[replay->frameNumber] = packInput(input);
+   replay->hashes[replay->frameNumber] = 0;
+
+   replay->frameNumber++;
+}
+
+/**
+ * \fn void recordHash(Replay* replay, Game* game)
+ * \brief records the state of the game at the end of the last recorded frame
+ *
+ * \param[in, out] replay: the Replay structure
+ * \param[in] game: the game, after the update of the frame
+ */
+void recordHash(Replay* replay, Game* game) {
+
+   if(replay->frameNumber > 0) {
+      replay->hashes[replay->frameNumber-1] = hashGame(game);
+   }
+}
+
+/**
+ * \fn int saveReplay(Replay* replay, char* path)
+ * \brief writes the recorded session in a file
+ *
+ * \param[in] replay: the Replay structure to save
+ * \param[in] path: path of the file
+ *
+ * The inputs are delta encoded: only the changes are written, with the number of frames
+ * they last. Returns 1 on success, 0 if the file can't be written.
+ */
+int saveReplay(Replay* replay, char* path) {
+
+   FILE* file;
+   int i, run;
+
+   if((file = fopen(path, "wb")) == NULL) {
+      fprintf(stderr, "can't write the replay %s\n", path);
+      return 0;
+   }
+
+   fwrite(REPLAY_MAGIC, 1, 4, file);
+   fputc(REPLAY_VERSION, file);
+
+   writeInt(file, replay->level);
+   writeInt(file, replay->onMenu);
+   writeInt(file, replay->x);
+   writeInt(file, replay->y);
+   writeInt(file, replay->life);
+   writeInt(file, replay->coin);
+   writeInt(file, replay->frameNumber);
+
+   for(i = 0; i < replay->frameNumber; i += run) {
+
+      run = 1;
+
+      while(i + run < replay->frameNumber && replay->inputs[i + run] == replay->inputs[i]) {
+         run++;
+      }
+
+      writeVarint(file, run);
+      fputc(replay->inputs[i], file);
+   }
+
+   for(i = 0; i < replay->frameNumber; i++) {
+      writeInt(file, replay->hashes[i]);
+   }
+
+   fclose(file);
+
+   return 1;
+}
+
+/**
+ * \fn Replay* loadReplay(char* path)
+ * \brief reads a session written by saveReplay()
+ *
+ * \param[in] path: path of the file
+ *
+ * If the file can't be read or is not a valid replay, the function returns NULL.
+ */
+Replay* loadReplay(char* path) {
+
+   FILE* file;
+   Replay* replay;
+   char magic[4];
+   unsigned int value, run, frameNumber;
+   int mask, i, ok;
+
+   if((file = fopen(path, "rb")) == NULL) {
+      fprintf(stderr, "can't read the replay %s\n", path);
+      return NULL;
+   }
+
+   if(fread(magic, 1, 4, file) != 4 || memcmp(magic, REPLAY_MAGIC, 4) != 0 || fgetc(file) != REPLAY_VERSION) {
+      fprintf(stderr, "%s is not a valid replay\n", path);
+      fclose(file);
+      return NULL;
+   }
+
+   if((replay = createReplay()) == NULL) {
+      fclose(file);
+      return NULL;
+   }
+
+   ok = readInt(file, &value);
+   replay->level = value;
+   ok = ok && readInt(file, &value);
+   replay->onMenu = value;
+   ok = ok && readInt(file, &value);
+   replay->x = value;
+   ok = ok && readInt(file, &value);
+   replay->y = value;
+   ok = ok && readInt(file, &value);
+   replay->life = value;
+   ok = ok && readInt(file, &value);
+   replay->coin = value;
+   ok = ok && readInt(file, &frameNumber);
+
+   /* inputs */
+   while(ok && replay->frameNumber < (int)frameNumber) {
+
+      ok = readVarint(file, &run) && (mask = fgetc(file)) != EOF && run > 0;
+
+      while(ok && run > 0 && replay->frameNumber < (int)frameNumber) {
+         growReplay(replay);
+         replay->inputs[replay->frameNumber] = mask;
+         replay->frameNumber++;
+         run--;
+      }
+   }
+
+   /* hashes */
+   for(i = 0; ok && i < replay->frameNumber; i++) {
+      ok = readInt(file, &replay->hashes[i]);
+   }
+
+   fclose(file);
+
+   if(!ok) {
+      fprintf(stderr, "%s is truncated\n", path);
+      destroyReplay(replay);
+      return NULL;
+   }
+
+   return replay;
+}
+
+/**
+ * \fn void startReplay(Replay* replay, Game* game)
+ * \brief puts the game back in the initial state of the recorded session
+ *
+ * \param[in, out] replay: the Replay structure to play
+ * \param[in, out] game: the game, already initialized
+ *
+ * Loads the recorded level if needed. The player starts without speed, as in a level just loaded:
+ * the replay doesn't store it, and a player coming from another level would keep his own.
+ */
+void startReplay(Replay* replay, Game* game) {
+
+   if(game->level != replay->level) {
+      game->level = replay->level;
+      initializePlayer(game->player, game);
+      loadGame(game);
+   }
+
+   game->onMenu = replay->onMenu;
+   game->menuType = START;
+   game->choice = 0;
+   game->player->x = replay->x;
+   game->player->y = replay->y;
+   game->player->dirX = 0;
+   game->player->dirY = 0;
+   game->life = replay->life;
+   game->coin = replay->coin;
+
+   replay->current = 0;
+}
+
+/**
+ * \fn int getReplayInput(Replay* replay, Input* input)
+ * \brief replaces getInput() while a session is played again
+ *
+ * \param[in, out] replay: the Replay structure being played
+ * \param[out] input: the Input structure to fill with the recorded inputs of the next frame
+ *
+ * Returns 0 when every recorded frame has been played, 1 otherwise.
+ */
+int getReplayInput(Replay* replay, Input* input) {
+
+   if(replay->current >= replay->frameNumber) {
+      return 0;
+   }
+
+   unpackInput(replay->inputs[replay->current], input);
+
+   replay->current++;
+
+   return 1;
+}
+
+/**
+ * \fn int checkReplayHash(Replay* replay, Game* game)
+ * \brief checks the state of the game against the recorded session
+ *
+ * \param[in] replay: the Replay structure being played
+ * \param[in] game: the game, after the update of the last played frame
+ *
+ * Returns 1 if the state is the recorded one, 0 if the replay diverged.
+ */
+int checkReplayHash(Replay* replay, Game* game) {
+
+   if(replay->current == 0) {
+      return 1;
+   }
+
+   return replay->hashes[replay->current-1] == hashGame(game);
+}
+
+/**
+ * \fn unsigned int hashGame(Game* game)
+ * \brief computes a hash of everything the inputs can change in the game
+ *
+ * \param[in] game: the Game structure
+ *
+ * Player, counters, menu and the state of every object of the level.
+ */
+unsigned int hashGame(Game* game) {
+
+   unsigned int hash = 2166136261u;
+   GameObject* object;
+   ObjectBatch* batch;
+   int i, slot;
+
+   hash = hashInt(hash, game->level);
+   hash = hashInt(hash, game->onMenu);
+   hash = hashInt(hash, game->menuType);
+   hash = hashInt(hash, game->choice);
+   hash = hashInt(hash, game->life);
+   hash = hashInt(hash, game->coin);
+
+   hash = hashInt(hash, game->player->x);
+   hash = hashInt(hash, game->player->y);
+   hash = hashFloat(hash, game->player->dirX);
+   hash = hashFloat(hash, game->player->dirY);
+   hash = hashInt(hash, game->player->etat);
+   hash = hashInt(hash, game->player->onGround);
+   hash = hashInt(hash, game->player->timerMort);
+
+   /* in the order of the TMX file, wherever the objects are stored */
+   for(i = 0; i < game->objectNumber; i++) {
+
+      slot = game->map->objectSlot[i];
+
+      if(game->map->objectType[i] != FLY) {
+         batch = &game->map->batches[game->map->objectType[i]];
+
+         hash = hashInt(hash, batch->initialized[slot]);
+         hash = hashInt(hash, batch->x[slot]);
+         hash = hashInt(hash, batch->y[slot]);
+
+         continue;
+      }
+
+      object = &game->map->monsters[slot];
+
+      hash = hashInt(hash, object->initialized);
+      hash = hashInt(hash, object->x);
+      hash = hashInt(hash, object->y);
+
+      /* the other fields are only set for the monsters already initialized */
+      if(object->initialized == 1) {
+         hash = hashInt(hash, object->direction);
+         hash = hashInt(hash, object->timerMort);
+      }
+   }
+
+   return hash;
+}
+
+/**
+ * \fn void destroyReplay(Replay* replay)
+ * \brief Free the Replay structure
+ *
+ * \param[in] replay: the Replay structure to free.
+ */
+void destroyReplay(Replay* replay) {
+
+   if(replay != NULL) {
+      free(replay->inputs);
+      free(replay->hashes);
+      free(replay);
+   }
+}
@@ -0,0 +1,54 @@
+/**
+ * \file replay.h
+ * \brief header of replay.c
+ *
+ * Creation of the Replay structure.
+ * Declaration of createReplay(), startRecording(), recordInput(), recordHash(), saveReplay(), loadReplay(),
+ * startReplay(), getReplayInput(), checkReplayHash(), hashGame() and destroyReplay().
+ *
+ * \author François-Xavier Balu, Gwendal Henry, Martin Parisot, Vincent Werner
+ */
+
+#ifndef REPLAY_H_INCLUDED
+#define REPLAY_H_INCLUDED
+
+#include "game.h"
+
+/* "NCPR" followed by the version of the file format */
+#define REPLAY_MAGIC "NCPR"
+#define REPLAY_VERSION 1
+
+
+typedef struct Replay{
+
+    /* état initial de la session */
+    int level;
+    int onMenu;
+    int x, y;
+    int life, coin;
+
+    /* un masque d'entrées et un hash de l'état du jeu par frame */
+    unsigned char *inputs;
+    unsigned int *hashes;
+    int frameNumber, frameMax;
+
+    /* frame en cours de lecture */
+    int current;
+
+}Replay;
+
+
+Replay* createReplay();
+void startRecording(Replay* replay, Game* game);
+void recordInput(Replay* replay, Input* input);
+void recordHash(Replay* replay, Game* game);
+int saveReplay(Replay* replay, char* path);
+Replay* loadReplay(char* path);
+void startReplay(Replay* replay, Game* game);
+int getReplayInput(Replay* replay, Input* input);
+int checkReplayHash(Replay* replay, Game* game);
+unsigned int hashGame(Game* game);
+void destroyReplay(Replay* replay);
+
+
+#endif // REPLAY_H_INCLUDED
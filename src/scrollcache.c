@@ -0,0 +1,293 @@
+/**
+ * \file scrollcache.c
+ * \brief contains the cache of the tile layer
+ *
+ * Implementation of createScrollCache, invalidateScrollCache, drawScrollCache and destroyScrollCache.
+ *
+ * The tiles don't change during a level, only the camera moves. The visible tiles are kept in a surface
+ * a little larger than the screen, used as a ring: the tile (x, y) of the map is always at
+ * (x % columns, y % rows) in the cache. When the camera moves, only the columns and rows of tiles
+ * which appear on the screen are copied in the cache, over the ones which disappeared.
+ * Then the cache is drawn on the screen in at most four parts, where the ring wraps around.
+ * Each part is cropped to the cells containing a tile, so the empty sky isn't blended for nothing.
+ *
+ * The copies go through drawOnSurface(), so they keep the alpha channel of the tileset:
+ * drawing the cache blends exactly the same pixels as drawing each tile.
+ *
+ * \author François-Xavier Balu, Gwendal Henry, Martin Parisot, Vincent Werner
+ */
+
+#include "scrollcache.h"
+#include "map.h"
+#include "chunk.h"
+#include "render.h"
+
+
+/**
+ * \fn ScrollCache* createScrollCache(SDL_Surface* tileSet)
+ * \brief Create the ScrollCache structure, with a surface in the format of the tileset
+ *
+ * \param[in] tileSet: the tileset, it must have an alpha channel.
+ *
+ * The cache is empty until drawScrollCache() is called.
+ */
+ScrollCache* createScrollCache(SDL_Surface* tileSet) {
+
+   ScrollCache* cache;
+   SDL_PixelFormat* format;
+
+   if(tileSet == NULL || tileSet->format->Amask == 0) return NULL;
+
+   if((cache = (ScrollCache*)malloc(sizeof(ScrollCache))) == NULL) {
+      fprintf(stderr, "can't allocate memory for a ScrollCache\n");
+
+      return NULL;
+   }
+
+   /* une tile de plus que l'écran, qui commence rarement au bord d'une tile */
+   cache->columns = (SCREEN_WIDTH + TILE_SIZE - 1) / TILE_SIZE + 1;
+   cache->rows = (SCREEN_HEIGHT + TILE_SIZE - 1) / TILE_SIZE + 1;
+   cache->x = cache->y = 0;
+   cache->valid = 0;
+
+   if((cache->filled = (unsigned char*)calloc(cache->columns * cache->rows, 1)) == NULL) {
+      fprintf(stderr, "can't allocate memory for a ScrollCache\n");
+      free(cache);
+
+      return NULL;
+   }
+
+   format = tileSet->format;
+
+   cache->surface = SDL_CreateRGBSurface(SDL_SWSURFACE | SDL_SRCALPHA, cache->columns * TILE_SIZE, cache->rows * TILE_SIZE,
+                                         format->BitsPerPixel, format->Rmask, format->Gmask, format->Bmask, format->Amask);
+
+   if(cache->surface == NULL) {
+      fprintf(stderr, "can't create the cache of the tiles: %s\n", SDL_GetError());
+      free(cache->filled);
+      free(cache);
+
+      return NULL;
+   }
+
+   SDL_SetAlpha(cache->surface, SDL_SRCALPHA, SDL_ALPHA_OPAQUE);
+
+   return cache;
+}
+
+/**
+ * \fn void invalidateScrollCache(ScrollCache* cache)
+ * \brief empties the cache, every visible tile will be copied again (new level)
+ */
+void invalidateScrollCache(ScrollCache* cache) {
+
+   if(cache != NULL) cache->valid = 0;
+}
+
+/**
+ * \fn static void clearTiles(ScrollCache* cache, int x1, int x2, int y)
+ * \brief empties the cells of the columns x1 to x2 - 1 of the row y of the map, in one or two parts of the ring
+ */
+static void clearTiles(ScrollCache* cache, int x1, int x2, int y) {
+
+   SDL_Rect dest;
+   int x, end;
+
+   for(x = x1; x < x2; x = end) {
+      /* jusqu'à la fin de la partie de l'anneau */
+      end = x2 < x - x % cache->columns + cache->columns ? x2 : x - x % cache->columns + cache->columns;
+
+      dest.x = (x % cache->columns) * TILE_SIZE;
+      dest.y = (y % cache->rows) * TILE_SIZE;
+      dest.w = (end - x) * TILE_SIZE;
+      dest.h = TILE_SIZE;
+
+      drawOnSurface(NULL, NULL, cache->surface, &dest);
+      memset(&cache->filled[(y % cache->rows) * cache->columns + x % cache->columns], 0, end - x);
+   }
+}
+
+/**
+ * \fn static void copyTiles(ScrollCache* cache, Map* map, int x1, int x2, int y1, int y2)
+ * \brief copies the tiles of the columns x1 to x2 - 1 and rows y1 to y2 - 1 of the map in the cache
+ *
+ * Only the spans of non-empty tiles are copied, the cells between them are cleared together.
+ */
+static void copyTiles(ScrollCache* cache, Map* map, int x1, int x2, int y1, int y2) {
+
+   TileSpan spans[SCREEN_WIDTH / TILE_SIZE + 2];
+   SDL_Rect src, dest;
+   int x, y, a, i, number;
+
+   src.w = dest.w = TILE_SIZE;
+   src.h = dest.h = TILE_SIZE;
+
+   for(y = y1; y < y2; y++) {
+      /* x : première colonne pas encore copiée */
+      x = x1;
+
+      /* les lignes hors de la map n'ont pas de tile */
+      number = getTileSpans(map, y, x1, x2, spans, SCREEN_WIDTH / TILE_SIZE + 2);
+
+      for(i = 0; i < number; i++) {
+         clearTiles(cache, x, spans[i].start, y);
+
+         for(x = spans[i].start; x < spans[i].end; x++) {
+            dest.x = (x % cache->columns) * TILE_SIZE;
+            dest.y = (y % cache->rows) * TILE_SIZE;
+
+            a = getTile(map, x, y) - 1;
+
+            /* tile hors du tileset : la case est effacée */
+            if(a / 10 * TILE_SIZE >= map->tileSet->h) {
+               drawOnSurface(NULL, NULL, cache->surface, &dest);
+               cache->filled[(y % cache->rows) * cache->columns + x % cache->columns] = 0;
+            } else {
+               src.x = a % 10 * TILE_SIZE;
+               src.y = a / 10 * TILE_SIZE;
+               drawOnSurface(map->tileSet, &src, cache->surface, &dest);
+               cache->filled[(y % cache->rows) * cache->columns + x % cache->columns] = 1;
+            }
+         }
+      }
+
+      clearTiles(cache, x, x2, y);
+   }
+}
+
+/**
+ * \fn static int cropToTiles(ScrollCache* cache, SDL_Rect* rect)
+ * \brief reduces a rectangle of the cache to the cells containing a tile
+ *
+ * Returns 0 if there is no tile in the rectangle.
+ */
+static int cropToTiles(ScrollCache* cache, SDL_Rect* rect) {
+
+   int x, y, left = rect->x + rect->w, right = rect->x, top = rect->y + rect->h, bottom = rect->y;
+
+   for(y = rect->y / TILE_SIZE; y * TILE_SIZE < rect->y + rect->h; y++) {
+      for(x = rect->x / TILE_SIZE; x * TILE_SIZE < rect->x + rect->w; x++) {
+         if(cache->filled[y * cache->columns + x] == 0) continue;
+
+         if(x * TILE_SIZE < left) left = x * TILE_SIZE;
+         if((x + 1) * TILE_SIZE > right) right = (x + 1) * TILE_SIZE;
+         if(y * TILE_SIZE < top) top = y * TILE_SIZE;
+         if((y + 1) * TILE_SIZE > bottom) bottom = (y + 1) * TILE_SIZE;
+      }
+   }
+
+   if(left < rect->x) left = rect->x;
+   if(right > rect->x + rect->w) right = rect->x + rect->w;
+   if(top < rect->y) top = rect->y;
+   if(bottom > rect->y + rect->h) bottom = rect->y + rect->h;
+
+   if(right <= left || bottom <= top) return 0;
+
+   rect->x = left;
+   rect->y = top;
+   rect->w = right - left;
+   rect->h = bottom - top;
+
+   return 1;
+}
+
+/**
+ * \fn int drawScrollCache(ScrollCache* cache, Map* map, Game* game)
+ * \brief updates the cache for the position of the camera and draws it on the screen
+ *
+ * \param[in, out] cache: the cache of the tiles.
+ * \param[in] map: the tiles and the position of the camera (startX, startY).
+ * \param[in] game: contains the screen.
+ *
+ * Returns 0 if the cache can't be used (camera out of the map), the tiles must then be drawn one by one.
+ */
+int drawScrollCache(ScrollCache* cache, Map* map, Game* game) {
+
+   SDL_Rect src, dest;
+   int x, y, first, last, width, height, i, j;
+   int partX[2], partY[2], partW[2], partH[2], partsX, partsY;
+
+   if(map->startX < 0 || map->startY < 0 || map->tileSet == NULL) return 0;
+
+   x = map->startX / TILE_SIZE;
+   y = map->startY / TILE_SIZE;
+
+   if(cache->valid == 0 || abs(x - cache->x) >= cache->columns || abs(y - cache->y) >= cache->rows) {
+      copyTiles(cache, map, x, x + cache->columns, y, y + cache->rows);
+   } else {
+      /* nouvelles colonnes, sur toute la hauteur */
+      first = x > cache->x ? cache->x + cache->columns : x;
+      last = x > cache->x ? x + cache->columns : cache->x;
+
+      if(first < last) copyTiles(cache, map, first, last, y, y + cache->rows);
+
+      /* nouvelles lignes, sur les colonnes restantes */
+      if(y != cache->y) {
+         i = y > cache->y ? cache->y + cache->rows : y;
+         j = y > cache->y ? y + cache->rows : cache->y;
+
+         if(x > cache->x) copyTiles(cache, map, x, cache->x + cache->columns, i, j);
+         else copyTiles(cache, map, cache->x, x + cache->columns, i, j);
+      }
+   }
+
+   cache->x = x;
+   cache->y = y;
+   cache->valid = 1;
+
+   /* l'écran dans l'anneau : une ou deux parties dans chaque direction */
+   width = cache->columns * TILE_SIZE;
+   height = cache->rows * TILE_SIZE;
+
+   partX[0] = map->startX % width;
+   partW[0] = width - partX[0] < SCREEN_WIDTH ? width - partX[0] : SCREEN_WIDTH;
+   partX[1] = 0;
+   partW[1] = SCREEN_WIDTH - partW[0];
+   partsX = partW[1] > 0 ? 2 : 1;
+
+   partY[0] = map->startY % height;
+   partH[0] = height - partY[0] < SCREEN_HEIGHT ? height - partY[0] : SCREEN_HEIGHT;
+   partY[1] = 0;
+   partH[1] = SCREEN_HEIGHT - partH[0];
+   partsY = partH[1] > 0 ? 2 : 1;
+
+   for(j = 0; j < partsY; j++) {
+      for(i = 0; i < partsX; i++) {
+         src.x = partX[i];
+         src.y = partY[j];
+         src.w = partW[i];
+         src.h = partH[j];
+
+         dest.x = i == 0 ? 0 : partW[0];
+         dest.y = j == 0 ? 0 : partH[0];
+
+         /* seulement la partie contenant des tiles */
+         dest.x -= src.x;
+         dest.y -= src.y;
+
+         if(cropToTiles(cache, &src) == 0) continue;
+
+         dest.x += src.x;
+         dest.y += src.y;
+         dest.w = src.w;
+         dest.h = src.h;
+
+         drawSurface(cache->surface, &src, &dest, game);
+      }
+   }
+
+   return 1;
+}
+
+/**
+ * \fn void destroyScrollCache(ScrollCache* cache)
+ * \brief Free the ScrollCache structure
+ */
+void destroyScrollCache(ScrollCache* cache) {
+
+   if(cache != NULL) {
+      freeImage(cache->surface);
+      free(cache->filled);
+      free(cache);
+   }
+}
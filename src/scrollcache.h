@@ -0,0 +1,39 @@
+/**
+ * \file scrollcache.h
+ * \brief header of scrollcache.c
+ *
+ * Creation of the ScrollCache structure.
+ * Declaration of createScrollCache(), invalidateScrollCache(), drawScrollCache() and destroyScrollCache().
+ *
+ * \author François-Xavier Balu, Gwendal Henry, Martin Parisot, Vincent Werner
+ */
+
+#ifndef SCROLLCACHE_H_INCLUDED
+#define SCROLLCACHE_H_INCLUDED
+
+#include "game.h"
+
+
+typedef struct ScrollCache{
+
+    /* anneau de columns x rows tiles : la tile (x, y) de la map est à (x % columns, y % rows) */
+    SDL_Surface *surface;
+    int columns, rows;
+
+    /* 1 pour chaque case de l'anneau contenant une tile */
+    unsigned char *filled;
+
+    /* première colonne et première ligne de la map en cache */
+    int x, y;
+    int valid;
+
+}ScrollCache;
+
+
+ScrollCache* createScrollCache(SDL_Surface* tileSet);
+void invalidateScrollCache(ScrollCache* cache);
+int drawScrollCache(ScrollCache* cache, Map* map, Game* game);
+void destroyScrollCache(ScrollCache* cache);
+
+
+#endif // SCROLLCACHE_H_INCLUDED
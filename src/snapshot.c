@@ -0,0 +1,98 @@
+/**
+ * \file snapshot.c
+ * \brief contains the copy of the state of a level just after it is loaded
+ *
+ * Implementation of createLevelSnapshot and restoreLevelSnapshot.
+ *
+ * During a level, only the state of the objects, the monsters and the blocks on the tiles
+ * (the switches add and remove blocks) change: the tiles, the batches and the trigger volumes stay the same.
+ * The snapshot copies these parts once the level is loaded, so restarting the level after a game over
+ * copies them back, without reading the TMX file or allocating memory again.
+ *
+ * \author François-Xavier Balu, Gwendal Henry, Martin Parisot, Vincent Werner
+ */
+
+#include "snapshot.h"
+#include "trigger.h"
+#include "arena.h"
+#include "objectbatch.h"
+
+
+/**
+ * \fn LevelSnapshot* createLevelSnapshot(Map* map, int level)
+ * \brief Copy the state of the level loaded in the map
+ *
+ * \param[in] map: the map, just after loadMap() ; the copy is allocated in its arena
+ * \param[in] level: number of the level
+ * \return the LevelSnapshot structure, NULL if the allocation failed: the level will be loaded again instead
+ */
+LevelSnapshot* createLevelSnapshot(Map* map, int level) {
+
+   LevelSnapshot* snapshot;
+   int t, number = 0;
+
+   if((snapshot = (LevelSnapshot*)arenaAlloc(map->arena, sizeof(LevelSnapshot))) == NULL) {
+      fprintf(stderr, "can't allocate memory for a LevelSnapshot\n");
+
+      return NULL;
+   }
+
+   for(t = 0; t < OBJECT_TYPES; t++) number += map->batches[t].number;
+
+   snapshot->level = level;
+   snapshot->objectNumber = number;
+   snapshot->monsterNumber = map->monsterNumber;
+   snapshot->blockTileNumber = map->blockTileNumber;
+
+   snapshot->initialized = (int*)arenaAlloc(map->arena, (number + 1) * sizeof(int));
+   snapshot->monsters = (GameObject*)arenaAlloc(map->arena, (map->monsterNumber + 1) * sizeof(GameObject));
+   snapshot->blockSolid = (unsigned char*)arenaAlloc(map->arena, snapshot->blockTileNumber + 1);
+
+   if(snapshot->initialized == NULL || snapshot->monsters == NULL || snapshot->blockSolid == NULL) {
+      fprintf(stderr, "can't allocate memory for a LevelSnapshot\n");
+
+      return NULL;
+   }
+
+   for(t = 0, number = 0; t < OBJECT_TYPES; t++) {
+      memcpy(snapshot->initialized + number, map->batches[t].initialized, map->batches[t].number * sizeof(int));
+      number += map->batches[t].number;
+   }
+
+   memcpy(snapshot->monsters, map->monsters, map->monsterNumber * sizeof(GameObject));
+
+   memcpy(snapshot->blockSolid, map->blockSolid, snapshot->blockTileNumber);
+
+   return snapshot;
+}
+
+/**
+ * \fn void restoreLevelSnapshot(LevelSnapshot* snapshot, Map* map)
+ * \brief Put the level back in the state copied by createLevelSnapshot()
+ *
+ * \param[in] snapshot: the copy of the level
+ * \param[in, out] map: the map, still containing the same level
+ *
+ * The camera goes back to the beginning of the level, and the player isn't in any trigger volume anymore.
+ * map->generation is incremented as if the level was loaded again: the objects being updated must stop.
+ */
+void restoreLevelSnapshot(LevelSnapshot* snapshot, Map* map) {
+
+   int t, number = 0;
+
+   for(t = 0; t < OBJECT_TYPES; t++) {
+      memcpy(map->batches[t].initialized, snapshot->initialized + number, map->batches[t].number * sizeof(int));
+      number += map->batches[t].number;
+   }
+
+   memcpy(map->monsters, snapshot->monsters, snapshot->monsterNumber * sizeof(GameObject));
+   map->monsterNumber = snapshot->monsterNumber;
+   sortMonsterBatch(map);
+
+   memcpy(map->blockSolid, snapshot->blockSolid, snapshot->blockTileNumber);
+
+   resetTriggerTable(map->triggers);
+
+   map->startX = map->startY = 0;
+   map->generation++;
+}
@@ -0,0 +1,40 @@
+/**
+ * \file snapshot.h
+ * \brief header of snapshot.c
+ *
+ * Creation of the LevelSnapshot structure.
+ * Declaration of createLevelSnapshot() and restoreLevelSnapshot().
+ *
+ * \author François-Xavier Balu, Gwendal Henry, Martin Parisot, Vincent Werner
+ */
+
+#ifndef SNAPSHOT_H_INCLUDED
+#define SNAPSHOT_H_INCLUDED
+
+#include "game.h"
+
+
+typedef struct LevelSnapshot{
+
+    /* niveau chargé dans la map quand l'état a été copié */
+    int level;
+
+    /* état (initialized) des objets immobiles, les batches bout à bout */
+    int *initialized;
+    int objectNumber;
+
+    GameObject *monsters;
+    int monsterNumber;
+
+    /* nombre de blocs solides sur chaque tile de Map.blockTiles au début du niveau */
+    unsigned char *blockSolid;
+    int blockTileNumber;
+
+}LevelSnapshot;
+
+
+LevelSnapshot* createLevelSnapshot(Map* map, int level);
+void restoreLevelSnapshot(LevelSnapshot* snapshot, Map* map);
+
+
+#endif // SNAPSHOT_H_INCLUDED
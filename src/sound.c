@@ -2,10 +2,15 @@
 
 void loadSong(int loop,char filename[200],Game* game ){
 
+    /* pas de carte son en mode headless */
+    if(game->headless) return;
+
     if(game->music != NULL)
     {
         Mix_HaltMusic();
-        Mix_FreeMusic(game->music);
+
+        /* la musique des niveaux reste chargée */
+        if(game->music != game->levelMusic) Mix_FreeMusic(game->music);
     }
 
     game->music = Mix_LoadMUS(filename);
@@ -22,9 +27,40 @@ void loadSong(int loop,char filename[200],Game* game ){
 }
 
 
+/* musique des niveaux : lue une seule fois, puis rejouée après un game over ou une fin de niveau */
+void playLevelSong(Game* game){
+
+    if(game->headless) return;
+
+    if(game->levelMusic == NULL)
+    {
+        game->levelMusic = Mix_LoadMUS("data/music/Those of Us Who Fight.mp3");
+        if(game->levelMusic == NULL)
+        {
+            fprintf(stderr, "Can't read the music \n");
+            exit(1);
+        }
+    }
+
+    if(game->music != NULL)
+    {
+        Mix_HaltMusic();
+        if(game->music != game->levelMusic) Mix_FreeMusic(game->music);
+    }
+
+    game->music = game->levelMusic;
+
+    if(Mix_PlayMusic(game->music, -1) == -1)
+    {
+        printf("Mix_PlayMusic: %s\n", Mix_GetError());
+    }
+}
+
 
 void loadSound(Game* game){
 
+   if(game->headless) return;
+
    if(game->miniondead_sound == NULL) game->miniondead_sound = Mix_LoadWAV("data/sounds/miniondead.wav");
    if (game->miniondead_sound == NULL)
     {
@@ -79,6 +115,8 @@ void freeSound(Game* game)
 void playSoundFx(int type, Game* game)
 {
 
+    if(game->headless) return;
+
     switch (type)
     {
 
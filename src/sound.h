@@ -16,6 +16,7 @@
 };
 
 void loadSong(int loop,char filename[200], Game* game );
+void playLevelSong(Game* game);
 void loadSound(Game* game);
 void freeSound(Game* game);
 void playSoundFx(int type, Game* game);
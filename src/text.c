@@ -0,0 +1,301 @@
+/**
+ * \file text.c
+ * \brief contains the cache of the rendered texts
+ *
+ * Implementation of createTextCache, getText, renderNumber and destroyTextCache.
+ *
+ * Rendering a text with SDL_ttf is slow, and the texts of the menus and the HUD
+ * don't change from one frame to the next. getText() renders a text once per
+ * (font, text, color) and gives the same surface afterwards.
+ * Numbers are composed from the digits of a GlyphAtlas with plain blits.
+ *
+ * \author François-Xavier Balu, Gwendal Henry, Martin Parisot, Vincent Werner
+ */
+
+#include "text.h"
+#include "render.h"
+
+
+/**
+ * \fn static Uint32 packColor(SDL_Color color)
+ * \brief packs a color into an integer, to compare the keys of the cache
+ */
+static Uint32 packColor(SDL_Color color) {
+
+   return ((Uint32)color.r << 16) | ((Uint32)color.g << 8) | color.b;
+}
+
+/**
+ * \fn static void destroyTextEntry(TextEntry* entry)
+ * \brief Free a TextEntry structure
+ */
+static void destroyTextEntry(TextEntry* entry) {
+
+   freeImage(entry->surface);
+   free(entry->text);
+   free(entry);
+}
+
+/**
+ * \fn TextCache* createTextCache()
+ * \brief Create the TextCache structure
+ *
+ * the TextCache structure is allocated and initialized.
+ * If the allocation failed the function returns NULL.
+ */
+TextCache* createTextCache() {
+
+   TextCache* cache;
+
+   if((cache = (TextCache*)malloc(sizeof(TextCache))) == NULL) {
+      fprintf(stderr, "can't allocate memory for a text cache\n");
+   } else {
+      cache->entries = NULL;
+      cache->entryNumber = 0;
+      cache->glyphs = NULL;
+   }
+
+   return cache;
+}
+
+/**
+ * \fn SDL_Surface* getText(TextCache* cache, TTF_Font* font, char* text, SDL_Color color)
+ * \brief gives the surface of a text, rendering it only the first time
+ *
+ * \param[in, out] cache: pointer to the TextCache structure.
+ * \param[in] font: font of the text.
+ * \param[in] text: the text.
+ * \param[in] color: color of the text.
+ *
+ * The surface belongs to the cache and must not be freed.
+ * When the cache is full, the least recently used text is freed.
+ * If the rendering fails, the function returns NULL.
+ */
+SDL_Surface* getText(TextCache* cache, TTF_Font* font, char* text, SDL_Color color) {
+
+   TextEntry **link, *entry;
+   Uint32 key = packColor(color);
+   int i;
+
+   for(link = &(cache->entries); *link != NULL; link = &((*link)->next)) {
+      entry = *link;
+
+      if(entry->font == font && entry->color == key && strcmp(entry->text, text) == 0) {
+         /* remis en tête de liste */
+         *link = entry->next;
+         entry->next = cache->entries;
+         cache->entries = entry;
+
+         return entry->surface;
+      }
+   }
+
+   if((entry = (TextEntry*)malloc(sizeof(TextEntry))) == NULL
+      || (entry->text = (char*)malloc(strlen(text) + 1)) == NULL) {
+      fprintf(stderr, "can't allocate memory for the text %s\n", text);
+      free(entry);
+
+      return NULL;
+   }
+
+   if((entry->surface = TTF_RenderUTF8_Blended(font, text, color)) == NULL) {
+      printf("Couldn't create String %s: %s\n", text, SDL_GetError());
+      free(entry->text);
+      free(entry);
+
+      return NULL;
+   }
+
+   strcpy(entry->text, text);
+   entry->font = font;
+   entry->color = key;
+
+   entry->next = cache->entries;
+   cache->entries = entry;
+   cache->entryNumber++;
+
+   /* libère le texte utilisé le moins récemment */
+   if(cache->entryNumber > TEXT_CACHE_SIZE) {
+      link = &(cache->entries);
+
+      for(i = 1; i < TEXT_CACHE_SIZE; i++) link = &((*link)->next);
+
+      entry = (*link)->next;
+      (*link)->next = NULL;
+
+      destroyTextEntry(entry);
+      cache->entryNumber--;
+   }
+
+   return cache->entries->surface;
+}
+
+/**
+ * \fn static GlyphAtlas* getGlyphAtlas(TextCache* cache, TTF_Font* font, SDL_Color color)
+ * \brief gives the digits of a font, rendering them the first time
+ *
+ * If the rendering fails, the function returns NULL.
+ */
+static GlyphAtlas* getGlyphAtlas(TextCache* cache, TTF_Font* font, SDL_Color color) {
+
+   GlyphAtlas* atlas;
+   SDL_Surface* digits[10];
+   SDL_PixelFormat* format;
+   SDL_Rect dest;
+   Uint32 key = packColor(color);
+   char digit[2] = "0";
+   int i, w = 0, h = 0;
+
+   for(atlas = cache->glyphs; atlas != NULL; atlas = atlas->next) {
+      if(atlas->font == font && atlas->color == key) return atlas;
+   }
+
+   for(i = 0; i < 10; i++) {
+      digit[0] = '0' + i;
+
+      if((digits[i] = TTF_RenderUTF8_Blended(font, digit, color)) == NULL) {
+         printf("Couldn't create String %s: %s\n", digit, SDL_GetError());
+
+         while(i-- > 0) SDL_FreeSurface(digits[i]);
+
+         return NULL;
+      }
+
+      w += digits[i]->w;
+      if(digits[i]->h > h) h = digits[i]->h;
+   }
+
+   if((atlas = (GlyphAtlas*)malloc(sizeof(GlyphAtlas))) == NULL) {
+      fprintf(stderr, "can't allocate memory for a glyph atlas\n");
+   } else {
+      format = digits[0]->format;
+
+      atlas->surface = SDL_CreateRGBSurface(SDL_SWSURFACE | SDL_SRCALPHA, w, h, format->BitsPerPixel,
+                                            format->Rmask, format->Gmask, format->Bmask, format->Amask);
+
+      if(atlas->surface == NULL) {
+         fprintf(stderr, "can't create the glyph atlas: %s\n", SDL_GetError());
+         free(atlas);
+         atlas = NULL;
+      }
+   }
+
+   w = 0;
+
+   for(i = 0; i < 10; i++) {
+      if(atlas != NULL) {
+         /* copie brute, pour garder la transparence du chiffre */
+         SDL_SetAlpha(digits[i], 0, SDL_ALPHA_OPAQUE);
+
+         dest.x = w;
+         dest.y = 0;
+         SDL_BlitSurface(digits[i], NULL, atlas->surface, &dest);
+
+         atlas->x[i] = w;
+         atlas->w[i] = digits[i]->w;
+      }
+
+      w += digits[i]->w;
+      SDL_FreeSurface(digits[i]);
+   }
+
+   if(atlas != NULL) {
+      atlas->font = font;
+      atlas->color = key;
+      atlas->next = cache->glyphs;
+      cache->glyphs = atlas;
+   }
+
+   return atlas;
+}
+
+/**
+ * \fn SDL_Surface* renderNumber(TextCache* cache, TTF_Font* font, char* digits, SDL_Color color)
+ * \brief composes a number from the digits of the font
+ *
+ * \param[in, out] cache: pointer to the TextCache structure.
+ * \param[in] font: font of the number.
+ * \param[in] digits: the number, only made of the characters '0' to '9'.
+ * \param[in] color: color of the number.
+ *
+ * No rendering is done once the digits of the font are in the cache, only blits.
+ * The caller owns the surface and frees it with freeImage().
+ * If the composition fails, the function returns NULL.
+ */
+SDL_Surface* renderNumber(TextCache* cache, TTF_Font* font, char* digits, SDL_Color color) {
+
+   GlyphAtlas* atlas;
+   SDL_Surface* number;
+   SDL_PixelFormat* format;
+   SDL_Rect src, dest;
+   int i, w = 0;
+
+   if((atlas = getGlyphAtlas(cache, font, color)) == NULL) return NULL;
+
+   for(i = 0; digits[i] != '\0'; i++) w += atlas->w[digits[i] - '0'];
+
+   format = atlas->surface->format;
+
+   number = SDL_CreateRGBSurface(SDL_SWSURFACE | SDL_SRCALPHA, w > 0 ? w : 1, atlas->surface->h,
+                                 format->BitsPerPixel, format->Rmask, format->Gmask, format->Bmask, format->Amask);
+
+   if(number == NULL) {
+      fprintf(stderr, "can't create the number %s: %s\n", digits, SDL_GetError());
+
+      return NULL;
+   }
+
+   SDL_SetAlpha(atlas->surface, 0, SDL_ALPHA_OPAQUE);
+
+   dest.x = 0;
+   dest.y = 0;
+
+   src.y = 0;
+   src.h = atlas->surface->h;
+
+   for(i = 0; digits[i] != '\0'; i++) {
+      src.x = atlas->x[digits[i] - '0'];
+      src.w = atlas->w[digits[i] - '0'];
+
+      SDL_BlitSurface(atlas->surface, &src, number, &dest);
+
+      dest.x += src.w;
+   }
+
+   SDL_SetAlpha(atlas->surface, SDL_SRCALPHA, SDL_ALPHA_OPAQUE);
+
+   return number;
+}
+
+/**
+ * \fn void destroyTextCache(TextCache* cache)
+ * \brief Free the TextCache structure and every surface in it
+ *
+ * \param[in] cache: pointer to the TextCache structure.
+ *
+ * To call before closing the fonts.
+ */
+void destroyTextCache(TextCache* cache) {
+
+   TextEntry* entry;
+   GlyphAtlas* atlas;
+
+   if(cache != NULL) {
+      while(cache->entries != NULL) {
+         entry = cache->entries;
+         cache->entries = entry->next;
+
+         destroyTextEntry(entry);
+      }
+
+      while(cache->glyphs != NULL) {
+         atlas = cache->glyphs;
+         cache->glyphs = atlas->next;
+
+         SDL_FreeSurface(atlas->surface);
+         free(atlas);
+      }
+
+      free(cache);
+   }
+}
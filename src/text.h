@@ -0,0 +1,64 @@
+/**
+ * \file text.h
+ * \brief header of text.c
+ *
+ * Creation of the TextCache structure.
+ * Declaration of createTextCache(), getText(), renderNumber() and destroyTextCache().
+ *
+ * \author François-Xavier Balu, Gwendal Henry, Martin Parisot, Vincent Werner
+ */
+
+#ifndef TEXT_H_INCLUDED
+#define TEXT_H_INCLUDED
+
+#include "common.h"
+
+/* nombre de textes gardés en cache */
+#define TEXT_CACHE_SIZE 64
+
+
+typedef struct TextEntry{
+
+    TTF_Font *font;
+    char *text;
+    Uint32 color;
+
+    SDL_Surface *surface;
+
+    struct TextEntry *next;
+
+}TextEntry;
+
+
+/* les chiffres d'une police, rendus une fois côte à côte */
+typedef struct GlyphAtlas{
+
+    TTF_Font *font;
+    Uint32 color;
+
+    SDL_Surface *surface;
+    int x[10], w[10];
+
+    struct GlyphAtlas *next;
+
+}GlyphAtlas;
+
+
+typedef struct TextCache{
+
+    /* du plus récemment utilisé au plus ancien */
+    TextEntry *entries;
+    int entryNumber;
+
+    GlyphAtlas *glyphs;
+
+}TextCache;
+
+
+TextCache* createTextCache();
+SDL_Surface* getText(TextCache* cache, TTF_Font* font, char* text, SDL_Color color);
+SDL_Surface* renderNumber(TextCache* cache, TTF_Font* font, char* digits, SDL_Color color);
+void destroyTextCache(TextCache* cache);
+
+
+#endif // TEXT_H_INCLUDED
@@ -0,0 +1,194 @@
+/**
+ * \file tmx.c
+ * \brief contains the reading of the tags of a TMX file one after the other
+ *
+ * Implementation of openTmxReader, readTmxTag, getTmxAttribute, getTmxInt and closeTmxReader.
+ *
+ * Unlike the XML module, no tree of the file is built: each call reads the next tag with its attributes.
+ * A level is read once, from the beginning to the end, when it is cooked (levelfile.h).
+ *
+ * \author François-Xavier Balu, Gwendal Henry, Martin Parisot, Vincent Werner
+ */
+
+#include "tmx.h"
+
+
+/**
+ * \fn static int nextChar(TmxReader* reader)
+ * \brief Read the next character of the file, EOF at the end
+ */
+static int nextChar(TmxReader* reader) {
+
+   return getc(reader->file);
+}
+
+/**
+ * \fn static int isBlank(int c)
+ * \brief tells if a character separates the attributes of a tag
+ */
+static int isBlank(int c) {
+
+   return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+/**
+ * \fn static int readText(TmxReader* reader, int c, char* text, int size, int end)
+ * \brief Read a name, or a value if end is its quote, starting with the character c
+ *
+ * \param[in, out] reader
+ * \param[in] c: first character, already read
+ * \param[out] text: the text, cut at size - 1 characters ; NULL to skip it
+ * \param[in] size: size of text
+ * \param[in] end: the quote closing a value, 0 for a name which ends at a blank, '=', '/' or '>'
+ * \return the character after the text
+ */
+static int readText(TmxReader* reader, int c, char* text, int size, int end) {
+
+   int n = 0;
+
+   while(c != EOF && (end != 0 ? c != end : (isBlank(c) == 0 && c != '=' && c != '/' && c != '>'))) {
+
+      if(text != NULL && n < size - 1) text[n++] = (char)c;
+
+      c = nextChar(reader);
+   }
+
+   if(text != NULL) text[n] = '\0';
+
+   return c;
+}
+
+/**
+ * \fn int openTmxReader(TmxReader* reader, const char* name)
+ * \brief Open a TMX file to read its tags from the beginning
+ *
+ * \param[out] reader
+ * \param[in] name: name of the file
+ * \return 0 if the file couldn't be opened, reader->file is then NULL
+ */
+int openTmxReader(TmxReader* reader, const char* name) {
+
+   if((reader->file = fopen(name, "rb")) == NULL) {
+      fprintf(stderr, "can't open the level %s\n", name);
+
+      return 0;
+   }
+
+   return 1;
+}
+
+/**
+ * \fn int readTmxTag(TmxReader* reader, TmxTag* tag)
+ * \brief Read the next tag of the file
+ *
+ * \param[in, out] reader
+ * \param[out] tag: its name and its attributes
+ * \return 0 at the end of the file
+ *
+ * The text between the tags, the declaration <?xml ?> and the comments are skipped.
+ * The attributes after the first TMX_ATTRIBUTES ones are ignored.
+ */
+int readTmxTag(TmxReader* reader, TmxTag* tag) {
+
+   char *name, *value;
+   int c, quote;
+
+   if(reader->file == NULL) return 0;
+
+   for(;;) {
+      while((c = nextChar(reader)) != '<') {
+         if(c == EOF) return 0;
+      }
+
+      if((c = nextChar(reader)) != '?' && c != '!') break;
+
+      while(c != '>') {
+         if(c == EOF) return 0;
+         c = nextChar(reader);
+      }
+   }
+
+   tag->closing = (c == '/');
+   tag->empty = 0;
+   tag->attributeNumber = 0;
+
+   if(tag->closing) c = nextChar(reader);
+
+   c = readText(reader, c, tag->name, TMX_NAME_SIZE, 0);
+
+   for(;;) {
+      while(isBlank(c)) c = nextChar(reader);
+
+      if(c == EOF) return 0;
+      if(c == '>') return 1;
+
+      if(c == '/') {
+         tag->empty = 1;
+         c = nextChar(reader);
+         continue;
+      }
+
+      name = value = NULL;
+
+      if(tag->attributeNumber < TMX_ATTRIBUTES) {
+         name = tag->attributeName[tag->attributeNumber];
+         value = tag->attributeValue[tag->attributeNumber];
+      }
+
+      c = readText(reader, c, name, TMX_NAME_SIZE, 0);
+
+      while(isBlank(c)) c = nextChar(reader);
+
+      /* attribut sans valeur : ignoré */
+      if(c != '=') continue;
+
+      c = nextChar(reader);
+      while(isBlank(c)) c = nextChar(reader);
+
+      if(c != '"' && c != '\'') continue;
+
+      quote = c;
+      c = readText(reader, nextChar(reader), value, TMX_VALUE_SIZE, quote);
+
+      if(c == EOF) return 0;
+
+      if(name != NULL) tag->attributeNumber++;
+
+      c = nextChar(reader);
+   }
+}
+
+/**
+ * \fn const char* getTmxAttribute(const TmxTag* tag, const char* name)
+ * \brief Give the value of an attribute of a tag, "" if it hasn't this attribute
+ */
+const char* getTmxAttribute(const TmxTag* tag, const char* name) {
+
+   int i;
+
+   for(i = 0; i < tag->attributeNumber; i++) {
+      if(strcmp(tag->attributeName[i], name) == 0) return tag->attributeValue[i];
+   }
+
+   return "";
+}
+
+/**
+ * \fn int getTmxInt(const TmxTag* tag, const char* name)
+ * \brief Give the value of an attribute of a tag as a number, 0 if it hasn't this attribute
+ */
+int getTmxInt(const TmxTag* tag, const char* name) {
+
+   return atoi(getTmxAttribute(tag, name));
+}
+
+/**
+ * \fn void closeTmxReader(TmxReader* reader)
+ * \brief Close the file of the reader, if it was opened
+ */
+void closeTmxReader(TmxReader* reader) {
+
+   if(reader->file != NULL) fclose(reader->file);
+
+   reader->file = NULL;
+}
@@ -0,0 +1,51 @@
+/**
+ * \file tmx.h
+ * \brief header of tmx.c
+ *
+ * Creation of the TmxReader and TmxTag structures.
+ * Declaration of openTmxReader(), readTmxTag(), getTmxAttribute(), getTmxInt() and closeTmxReader().
+ *
+ * \author François-Xavier Balu, Gwendal Henry, Martin Parisot, Vincent Werner
+ */
+
+#ifndef TMX_H_INCLUDED
+#define TMX_H_INCLUDED
+
+#include "common.h"
+
+/* tailles maximales des noms et des valeurs lus, le reste est ignoré */
+#define TMX_NAME_SIZE 32
+#define TMX_VALUE_SIZE 64
+#define TMX_ATTRIBUTES 12
+
+
+typedef struct TmxReader{
+
+    FILE *file;
+
+}TmxReader;
+
+
+typedef struct TmxTag{
+
+    /* nom de la balise, sans le '/' */
+    char name[TMX_NAME_SIZE];
+
+    /* 1 pour </name>, empty à 1 pour <name/> */
+    int closing, empty;
+
+    char attributeName[TMX_ATTRIBUTES][TMX_NAME_SIZE];
+    char attributeValue[TMX_ATTRIBUTES][TMX_VALUE_SIZE];
+    int attributeNumber;
+
+}TmxTag;
+
+
+int openTmxReader(TmxReader* reader, const char* name);
+int readTmxTag(TmxReader* reader, TmxTag* tag);
+const char* getTmxAttribute(const TmxTag* tag, const char* name);
+int getTmxInt(const TmxTag* tag, const char* name);
+void closeTmxReader(TmxReader* reader);
+
+
+#endif // TMX_H_INCLUDED
@@ -0,0 +1,284 @@
+/**
+ * \file trigger.c
+ * \brief contains the trigger volumes of the objects which don't move
+ *
+ * Implementation of createTriggerTable, updateTriggers and resetTriggerTable.
+ *
+ * Each object which doesn't move (coin, door, spike, switch, block) is a trigger volume: the tiles
+ * its square covers. The volumes are stored in a table indexed by chunk of tiles (chunk.h), filled when
+ * the level is loaded, so its size doesn't grow with the tiles of the level. The table is only looked up
+ * when the player covers other tiles than before: the volumes touching the tiles of the player
+ * are the active ones, sorted in the order of evaluation. Each frame only the active
+ * volumes are evaluated, with the enter, stay and use events of their type, and the exit event when
+ * the player leaves their tiles. The objects far from the player cost nothing.
+ *
+ * \author François-Xavier Balu, Gwendal Henry, Martin Parisot, Vincent Werner
+ */
+
+#include "trigger.h"
+#include "chunk.h"
+#include "arena.h"
+
+
+/**
+ * \fn static int clampTile(int position, int size)
+ * \brief Give the tile of a position in pixels, the nearest one of the map when the position is outside
+ */
+static int clampTile(int position, int size) {
+
+   int tile = position / TILE_SIZE;
+
+   if(tile < 0) return 0;
+   if(tile >= size) return size - 1;
+
+   return tile;
+}
+
+/**
+ * \fn static void getVolumeTiles(Map* map, TriggerTable* table, int i, int* x0, int* y0, int* x1, int* y1)
+ * \brief Give the tiles covered by the volume i: the columns x0 to x1 and the rows y0 to y1
+ */
+static void getVolumeTiles(Map* map, TriggerTable* table, int i, int* x0, int* y0, int* x1, int* y1) {
+
+   ObjectBatch* batch = &map->batches[table->type[i]];
+
+   *x0 = clampTile(batch->x[table->slot[i]], table->columns);
+   *x1 = clampTile(batch->x[table->slot[i]] + TILE_SIZE - 1, table->columns);
+   *y0 = clampTile(batch->y[table->slot[i]], table->rows);
+   *y1 = clampTile(batch->y[table->slot[i]] + TILE_SIZE - 1, table->rows);
+}
+
+/**
+ * \fn TriggerTable* createTriggerTable(Map* map, const TriggerType* types, const int* order, int orderNumber)
+ * \brief Create the trigger volumes of the objects of the batches of a map
+ *
+ * \param[in] map: the map, with its batches filled ; the volumes are allocated in its arena
+ * \param[in] types: the events of each type of object, indexed by batch
+ * \param[in] order: the batches having trigger volumes, in the order they are evaluated
+ * \param[in] orderNumber: number of batches in order
+ * \return the TriggerTable structure, with no active volume
+ *
+ * The objects of a batch are evaluated in the order of the batch.
+ * A volume is the square of TILE_SIZE pixels of its object, as in collideObject().
+ */
+TriggerTable* createTriggerTable(Map* map, const TriggerType* types, const int* order, int orderNumber) {
+
+   TriggerTable* table;
+   int i, k, t, x, y, x0, y0, x1, y1, cellNumber, *position;
+
+   if((table = (TriggerTable*)arenaAlloc(map->arena, sizeof(TriggerTable))) == NULL) {
+      printf("Couldn't allocate the trigger volumes of the level\n");
+      exit(1);
+   }
+
+   table->types = types;
+   table->columns = map->sizeX > 0 ? map->sizeX : 1;
+   table->rows = map->sizeY > 0 ? map->sizeY : 1;
+   table->chunkColumns = (table->columns + CHUNK_SIZE - 1) / CHUNK_SIZE;
+   table->chunkRows = (table->rows + CHUNK_SIZE - 1) / CHUNK_SIZE;
+   cellNumber = table->chunkColumns * table->chunkRows;
+
+   table->number = 0;
+   for(k = 0; k < orderNumber; k++) table->number += map->batches[order[k]].number;
+
+   table->type = (int*)arenaAlloc(map->arena, (table->number + 1) * sizeof(int));
+   table->slot = (int*)arenaAlloc(map->arena, (table->number + 1) * sizeof(int));
+   table->active = (int*)arenaAlloc(map->arena, (table->number + 1) * sizeof(int));
+   table->previous = (int*)arenaAlloc(map->arena, (table->number + 1) * sizeof(int));
+   table->stamp = (int*)arenaAlloc(map->arena, (table->number + 1) * sizeof(int));
+   table->inside = (unsigned char*)arenaAlloc(map->arena, table->number + 1);
+   table->cellStart = (int*)arenaAlloc(map->arena, (cellNumber + 1) * sizeof(int));
+   position = (int*)arenaAlloc(map->arena, (cellNumber + 1) * sizeof(int));
+
+   if(table->type == NULL || table->slot == NULL || table->active == NULL || table->previous == NULL || table->stamp == NULL ||
+      table->inside == NULL || table->cellStart == NULL || position == NULL) {
+      printf("Couldn't allocate the trigger volumes of %d objects\n", table->number);
+      exit(1);
+   }
+
+   memset(table->stamp, 0, (table->number + 1) * sizeof(int));
+   memset(table->inside, 0, table->number + 1);
+   memset(table->cellStart, 0, (cellNumber + 1) * sizeof(int));
+
+   for(i = 0, k = 0; k < orderNumber; k++) {
+      for(t = 0; t < map->batches[order[k]].number; t++, i++) {
+         table->type[i] = order[k];
+         table->slot[i] = t;
+      }
+   }
+
+   /* deux passes : le nombre de volumes de chaque chunk, puis les volumes */
+   for(k = 0; k < 2; k++) {
+
+      for(i = 0; i < table->number; i++) {
+
+         getVolumeTiles(map, table, i, &x0, &y0, &x1, &y1);
+
+         for(y = y0 / CHUNK_SIZE; y <= y1 / CHUNK_SIZE; y++) {
+            for(x = x0 / CHUNK_SIZE; x <= x1 / CHUNK_SIZE; x++) {
+
+               if(k == 0) table->cellStart[y * table->chunkColumns + x + 1]++;
+
+               else table->cells[position[y * table->chunkColumns + x]++] = i;
+            }
+         }
+      }
+
+      if(k == 0) {
+
+         for(i = 0; i < cellNumber; i++) table->cellStart[i + 1] += table->cellStart[i];
+         for(i = 0; i < cellNumber; i++) position[i] = table->cellStart[i];
+
+         if((table->cells = (int*)arenaAlloc(map->arena, (table->cellStart[cellNumber] + 1) * sizeof(int))) == NULL) {
+            printf("Couldn't allocate the trigger volumes of %d objects\n", table->number);
+            exit(1);
+         }
+      }
+   }
+
+   /* aucune tile : le premier appel de updateTriggers() cherche les volumes actifs */
+   table->activeNumber = 0;
+   table->x0 = table->y0 = 0;
+   table->x1 = table->y1 = -1;
+   table->stampValue = 0;
+
+   return table;
+}
+
+/**
+ * \fn static int refreshTriggers(Game* game, TriggerTable* table)
+ * \brief Find the active volumes again if the player covers other tiles, and send the exit events
+ *
+ * \param[in, out] game
+ * \param[in, out] table: the trigger volumes of the map of the game
+ * \return 1 if the active volumes changed
+ */
+static int refreshTriggers(Game* game, TriggerTable* table) {
+
+   GameObject* player = game->player;
+   ObjectBatch* batch;
+   int i, j, k, x, y, cell, x0, y0, x1, y1, vx0, vy0, vx1, vy1, previousNumber = table->activeNumber;
+
+   x0 = clampTile(player->x, table->columns);
+   x1 = clampTile(player->x + player->w - 1, table->columns);
+   y0 = clampTile(player->y, table->rows);
+   y1 = clampTile(player->y + player->h - 1, table->rows);
+
+   if(x0 == table->x0 && y0 == table->y0 && x1 == table->x1 && y1 == table->y1) return 0;
+
+   table->x0 = x0;
+   table->y0 = y0;
+   table->x1 = x1;
+   table->y1 = y1;
+   table->stampValue++;
+
+   /* les volumes actifs d'avant, pour trouver ceux qui ne le sont plus */
+   for(i = 0; i < previousNumber; i++) table->previous[i] = table->active[i];
+
+   table->activeNumber = 0;
+
+   for(y = y0 / CHUNK_SIZE; y <= y1 / CHUNK_SIZE; y++) {
+      for(x = x0 / CHUNK_SIZE; x <= x1 / CHUNK_SIZE; x++) {
+
+         cell = y * table->chunkColumns + x;
+
+         for(k = table->cellStart[cell]; k < table->cellStart[cell + 1]; k++) {
+
+            i = table->cells[k];
+
+            if(table->stamp[i] == table->stampValue) continue;
+
+            /* le chunk est plus grand que les tiles du joueur */
+            getVolumeTiles(game->map, table, i, &vx0, &vy0, &vx1, &vy1);
+
+            if(vx1 < x0 || vx0 > x1 || vy1 < y0 || vy0 > y1) continue;
+
+            table->stamp[i] = table->stampValue;
+
+            /* tri par insertion, le joueur ne touche que quelques volumes */
+            for(j = table->activeNumber++; j > 0 && table->active[j - 1] > i; j--) table->active[j] = table->active[j - 1];
+
+            table->active[j] = i;
+         }
+      }
+   }
+
+   for(k = 0; k < previousNumber; k++) {
+
+      i = table->previous[k];
+
+      if(table->stamp[i] == table->stampValue || table->inside[i] == 0) continue;
+
+      table->inside[i] = 0;
+      batch = &game->map->batches[table->type[i]];
+
+      if(table->types[table->type[i]].exit != NULL) table->types[table->type[i]].exit(game, batch, table->slot[i]);
+   }
+
+   return 1;
+}
+
+/**
+ * \fn int updateTriggers(Game* game)
+ * \brief Evaluate the trigger volumes touching the tiles of the player, in their order
+ *
+ * \param[in, out] game
+ * \return 1 if an event loaded a level, the volumes of the previous one are destroyed
+ *
+ * Each active volume gets its enter event the first time, then its stay event, then its use event
+ * if the player presses use. When an event moves the player on other tiles, the active volumes
+ * are found again and the evaluation continues after the current volume.
+ */
+int updateTriggers(Game* game) {
+
+   TriggerTable* table = game->map->triggers;
+   const TriggerType* type;
+   ObjectBatch* batch;
+   int i, k, generation = game->map->generation;
+
+   refreshTriggers(game, table);
+
+   for(k = 0; k < table->activeNumber; k++) {
+
+      i = table->active[k];
+      type = &table->types[table->type[i]];
+      batch = &game->map->batches[table->type[i]];
+
+      if(table->inside[i] == 0) {
+         table->inside[i] = 1;
+
+         if(type->enter != NULL) type->enter(game, batch, table->slot[i]);
+      }
+
+      else if(type->stay != NULL) type->stay(game, batch, table->slot[i]);
+
+      if(game->map->generation != generation) return 1;
+
+      if(game->input->use == 1 && type->use != NULL) type->use(game, batch, table->slot[i]);
+
+      if(game->map->generation != generation) return 1;
+
+      /* le joueur a été poussé sur d'autres tiles : on reprend au premier volume après celui-ci */
+      if(refreshTriggers(game, table)) {
+         for(k = 0; k < table->activeNumber && table->active[k] <= i; k++);
+         k--;
+      }
+   }
+
+   return 0;
+}
+
+/**
+ * \fn void resetTriggerTable(TriggerTable* table)
+ * \brief Forget the active volumes, as after createTriggerTable(): the player is in none of them
+ */
+void resetTriggerTable(TriggerTable* table) {
+
+   if(table == NULL) return;
+
+   memset(table->inside, 0, table->number + 1);
+
+   table->activeNumber = 0;
+   table->x0 = table->y0 = 0;
+   table->x1 = table->y1 = -1;
+}
@@ -0,0 +1,65 @@
+/**
+ * \file trigger.h
+ * \brief header of trigger.c
+ *
+ * Creation of the TriggerType and TriggerTable structures.
+ * Declaration of createTriggerTable(), updateTriggers() and resetTriggerTable().
+ *
+ * \author François-Xavier Balu, Gwendal Henry, Martin Parisot, Vincent Werner
+ */
+
+#ifndef TRIGGER_H_INCLUDED
+#define TRIGGER_H_INCLUDED
+
+#include "game.h"
+
+
+/* événement d'un objet immobile, à sa place slot dans sa batch */
+typedef void (*TriggerEvent)(Game* game, ObjectBatch* batch, int slot);
+
+
+/* ce que fait un type d'objet quand le joueur entre dans les tiles de l'objet, y reste, en sort,
+   ou appuie sur use pendant qu'il y est ; NULL quand il ne fait rien */
+typedef struct TriggerType{
+
+    TriggerEvent enter, stay, exit, use;
+
+}TriggerType;
+
+
+typedef struct TriggerTable{
+
+    /* batch et place de chaque volume, dans l'ordre où ils sont évalués */
+    int *type, *slot;
+    int number;
+
+    const TriggerType *types;
+
+    /* volumes qui touchent le chunk (cx, cy) : cells[cellStart[cy * chunkColumns + cx]] à
+       cells[cellStart[cy * chunkColumns + cx + 1] - 1] ; la map fait columns x rows tiles */
+    int *cellStart, *cells;
+    int chunkColumns, chunkRows;
+    int columns, rows;
+
+    /* volumes qui touchent les tiles couvertes par le joueur, triés, et le rectangle de ces tiles */
+    int *active;
+    int activeNumber;
+    int *previous;
+    int x0, y0, x1, y1;
+
+    /* 1 pour un volume où le joueur est entré, jusqu'à ce qu'il en sorte */
+    unsigned char *inside;
+
+    /* marque des volumes déjà rangés dans active */
+    int *stamp;
+    int stampValue;
+
+}TriggerTable;
+
+
+TriggerTable* createTriggerTable(Map* map, const TriggerType* types, const int* order, int orderNumber);
+int updateTriggers(Game* game);
+void resetTriggerTable(TriggerTable* table);
+
+
+#endif // TRIGGER_H_INCLUDED